@@ -25,6 +25,8 @@
 #include "bgpd/bgp_mplsvpn.h"
 #include "bgpd/bgp_updgrp.h"
 
+DEFINE_MPOOL_STATIC(BGP_ADJ_IN, BGP_ADJ_IN, sizeof(struct bgp_adj_in));
+
 /* BGP advertise attribute is used for pack same attribute update into
    one packet.  To do that we maintain attribute hash in struct
    peer.  */
@@ -182,7 +184,7 @@ void bgp_adj_in_set(struct bgp_dest *dest, struct peer *peer, struct attr *attr,
 			return;
 		}
 	}
-	adj = XCALLOC(MTYPE_BGP_ADJ_IN, sizeof(struct bgp_adj_in));
+	adj = XPOOL_CALLOC(BGP_ADJ_IN);
 	adj->peer = peer_lock(peer); /* adj_in peer reference */
 	adj->attr = bgp_attr_intern(attr);
 	adj->uptime = monotime(NULL);
@@ -202,7 +204,7 @@ void bgp_adj_in_remove(struct bgp_dest **dest, struct bgp_adj_in *bai)
 	BGP_ADJ_IN_DEL(*dest, bai);
 	*dest = bgp_dest_unlock_node(*dest);
 	peer_unlock(bai->peer); /* adj_in peer reference */
-	XFREE(MTYPE_BGP_ADJ_IN, bai);
+	XPOOL_FREE(BGP_ADJ_IN, bai);
 }
 
 bool bgp_adj_in_unset(struct bgp_dest **dest, struct peer *peer,
@@ -317,6 +317,9 @@ void aspath_free(struct aspath *aspath)
 		aspath->json = NULL;
 	}
 
+	if (CHECK_FLAG(aspath->flat_flags, ASPATH_FLAT_OWNED))
+		XFREE(MTYPE_AS_FLAT, aspath->flat);
+
 	XFREE(MTYPE_AS_PATH, aspath);
 }
 
@@ -726,11 +729,12 @@ struct aspath *aspath_dup(struct aspath *aspath)
 
 static void *aspath_hash_alloc(void *arg)
 {
-	const struct aspath *aspath = arg;
+	struct aspath *aspath = arg;
 	struct aspath *new;
 
-	/* Malformed AS path value. */
-	assert(aspath->str);
+	/* The string is only needed once the path is actually new */
+	if (!aspath->str)
+		aspath_str_update(aspath, false);
 
 	/* New aspath structure is needed. */
 	new = XMALLOC(MTYPE_AS_PATH, sizeof(struct aspath));
@@ -743,6 +747,10 @@ static void *aspath_hash_alloc(void *arg)
 	new->json = aspath->json;
 	new->asnotation = aspath->asnotation;
 	new->count = aspath->count;
+	new->flat = NULL;
+	new->flat_len = 0;
+	new->flat_flags = 0;
+	new->bloom = 0;
 
 	return new;
 }
@@ -878,7 +886,6 @@ struct aspath *aspath_parse(struct stream *s, size_t length, int use32bit,
 	/* if the aspath was already hashed free temporary memory. */
 	if (find->refcnt) {
 		assegment_free_all(as.segments);
-		/* aspath_key_make() always updates the string */
 		XFREE(MTYPE_AS_STR, as.str);
 		if (as.json) {
 			json_object_free(as.json);
@@ -1191,6 +1198,88 @@ unsigned int aspath_get_last_as(struct aspath *aspath)
 	return last_as;
 }
 
+/* Bloom filter bits of an ASN, two out of 64. */
+static inline uint64_t aspath_bloom_bits(as_t asno)
+{
+	uint32_t h = asno * 0x9e3779b1U;
+
+	return (1ULL << (h >> 26)) | (1ULL << ((h >> 20) & 0x3f));
+}
+
+/* Build the flattened ASN array and bloom filter of an interned path.
+ * Returns false if they are not available, i.e. the path is not interned
+ * and its segments may still change.
+ */
+static bool aspath_flatten(struct aspath *aspath)
+{
+	const struct assegment *seg;
+	as_t *flat;
+	uint32_t len = 0;
+	uint32_t i;
+	uint8_t flags = ASPATH_FLAT_VALID;
+	uint64_t bloom = 0;
+
+	if (CHECK_FLAG(aspath->flat_flags, ASPATH_FLAT_VALID))
+		return true;
+
+	if (!aspath->refcnt)
+		return false;
+
+	for (seg = aspath->segments; seg; seg = seg->next) {
+		len += seg->length;
+		if (seg->type == AS_CONFED_SEQUENCE || seg->type == AS_CONFED_SET)
+			SET_FLAG(flags, ASPATH_FLAT_CONFED);
+	}
+
+	/* Normalised paths usually have a single segment, use it as is */
+	if (!len) {
+		flat = NULL;
+	} else if (!aspath->segments->next) {
+		flat = aspath->segments->as;
+	} else {
+		flat = XMALLOC(MTYPE_AS_FLAT, len * sizeof(as_t));
+		SET_FLAG(flags, ASPATH_FLAT_OWNED);
+
+		len = 0;
+		for (seg = aspath->segments; seg; seg = seg->next) {
+			memcpy(flat + len, seg->as, seg->length * sizeof(as_t));
+			len += seg->length;
+		}
+	}
+
+	/* Same semantics as the segment walk: an empty path is not private */
+	if (aspath->segments)
+		SET_FLAG(flags, ASPATH_FLAT_PRIVATE);
+
+	for (i = 0; i < len; i++) {
+		bloom |= aspath_bloom_bits(flat[i]);
+		if (!BGP_AS_IS_PRIVATE(flat[i]))
+			UNSET_FLAG(flags, ASPATH_FLAT_PRIVATE);
+	}
+
+	aspath->flat = flat;
+	aspath->flat_len = len;
+	aspath->bloom = bloom;
+	aspath->flat_flags = flags;
+	return true;
+}
+
+/* Count the occurrences of asno in a flattened path. */
+static int aspath_flat_count(const struct aspath *aspath, as_t asno)
+{
+	uint64_t bits = aspath_bloom_bits(asno);
+	int count = 0;
+	uint32_t i;
+
+	if ((aspath->bloom & bits) != bits)
+		return 0;
+
+	for (i = 0; i < aspath->flat_len; i++)
+		count += (aspath->flat[i] == asno);
+
+	return count;
+}
+
 /* AS path loop check.  If aspath contains asno then return >= 1. */
 int aspath_loop_check(struct aspath *aspath, as_t asno)
 {
@@ -1200,6 +1289,9 @@ int aspath_loop_check(struct aspath *aspath, as_t asno)
 	if ((aspath == NULL) || (aspath->segments == NULL))
 		return 0;
 
+	if (aspath_flatten(aspath))
+		return aspath_flat_count(aspath, asno);
+
 	seg = aspath->segments;
 
 	while (seg) {
@@ -1225,6 +1317,15 @@ int aspath_loop_check_confed(struct aspath *aspath, as_t asno)
 	if (aspath == NULL || aspath->segments == NULL)
 		return 0;
 
+	if (aspath_flatten(aspath)) {
+		uint64_t bits = aspath_bloom_bits(asno);
+
+		if ((aspath->bloom & bits) != bits)
+			return 0;
+		if (!CHECK_FLAG(aspath->flat_flags, ASPATH_FLAT_CONFED))
+			return aspath_flat_count(aspath, asno);
+	}
+
 	seg = aspath->segments;
 
 	while (seg) {
@@ -1249,6 +1350,9 @@ bool aspath_private_as_check(struct aspath *aspath)
 	if (!(aspath && aspath->segments))
 		return false;
 
+	if (aspath_flatten(aspath))
+		return CHECK_FLAG(aspath->flat_flags, ASPATH_FLAT_PRIVATE);
+
 	seg = aspath->segments;
 
 	while (seg) {
@@ -2269,16 +2373,20 @@ struct aspath *aspath_str2aspath(const char *str,
 	return aspath;
 }
 
-/* Make hash value by raw aspath data. */
+/* Make hash value by raw aspath data.  Segments are normalised, so
+ * hashing them directly is consistent with aspath_cmp() and saves
+ * building the string for paths that are already known.
+ */
 unsigned int aspath_key_make(const void *p)
 {
 	const struct aspath *aspath = p;
-	unsigned int key = 0;
-
-	if (!aspath->str)
-		aspath_str_update((struct aspath *)aspath, false);
+	const struct assegment *seg;
+	unsigned int key = 2334325;
 
-	key = jhash(aspath->str, aspath->str_len, 2334325);
+	key = jhash_1word(aspath->asnotation, key);
+	for (seg = aspath->segments; seg; seg = seg->next)
+		key = jhash2(seg->as, seg->length,
+			     jhash_2words(seg->type, seg->length, key));
 
 	return key;
 }
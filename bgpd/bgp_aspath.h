@@ -63,6 +63,19 @@ struct aspath {
 
 	/* AS notation used by string expression of AS path */
 	enum asnotation_mode asnotation;
+
+	/* All ASNs of the path in order, and a bloom filter over them.
+	 * Built on first use once the path is interned, so that loop and
+	 * private AS checks need not walk the segments.
+	 */
+	as_t *flat;
+	uint32_t flat_len;
+	uint8_t flat_flags;
+#define ASPATH_FLAT_VALID   (1 << 0)
+#define ASPATH_FLAT_OWNED   (1 << 1) /* flat is allocated, not a segment */
+#define ASPATH_FLAT_CONFED  (1 << 2) /* path has confed segments */
+#define ASPATH_FLAT_PRIVATE (1 << 3) /* every ASN is private */
+	uint64_t bloom;
 };
 
 #define ASPATH_STR_DEFAULT_LEN 32
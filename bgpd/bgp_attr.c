@@ -210,6 +210,7 @@ static struct hash *vnc_hash = NULL;
 static struct hash *srv6_l3service_hash;
 static struct hash *srv6_vpn_hash;
 static struct hash *evpn_overlay_hash;
+static struct hash *attr_ext_hash;
 static struct hash *bgp_nhc_hash;
 
 struct bgp_attr_encap_subtlv *encap_tlv_dup(struct bgp_attr_encap_subtlv *orig)
@@ -682,6 +683,149 @@ static void evpn_overlay_finish(void)
 			    (void (*)(void *))evpn_overlay_free);
 }
 
+/* Values of an attr that carries no extension block. */
+static const struct bgp_attr_ext attr_ext_default;
+
+static const struct bgp_attr_ext *attr_ext(const struct attr *attr)
+{
+	return attr->ext ? attr->ext : &attr_ext_default;
+}
+
+static bool attr_ext_same(const struct bgp_attr_ext *e1,
+			  const struct bgp_attr_ext *e2)
+{
+	if (e1 == e2)
+		return true;
+
+	return e1->aigp_metric == e2->aigp_metric &&
+	       e1->pmsi_tnl_type == e2->pmsi_tnl_type &&
+	       IPV6_ADDR_SAME(&e1->tunn_id, &e2->tunn_id) &&
+	       e1->mm_seqnum == e2->mm_seqnum &&
+	       e1->mm_sync_seqnum == e2->mm_sync_seqnum &&
+	       e1->df_pref == e2->df_pref && e1->df_alg == e2->df_alg;
+}
+
+/*
+ * Return the extension block of a non-interned attr for modification.  A
+ * private block (refcnt 0) belongs to this attr and is changed in place;
+ * an interned one is shared, so a private copy is made first.
+ */
+struct bgp_attr_ext *bgp_attr_ext_get(struct attr *attr)
+{
+	struct bgp_attr_ext *ext = attr->ext;
+
+	if (ext && !ext->refcnt)
+		return ext;
+
+	attr->ext = XMALLOC(MTYPE_BGP_ATTR_EXT, sizeof(struct bgp_attr_ext));
+	*attr->ext = ext ? *ext : attr_ext_default;
+	attr->ext->refcnt = 0;
+	return attr->ext;
+}
+
+static void attr_ext_free(struct bgp_attr_ext *ext)
+{
+	XFREE(MTYPE_BGP_ATTR_EXT, ext);
+}
+
+/*
+ * Give attr, a shallow copy of another non-interned attr, its own private
+ * extension block.  Otherwise both would point to the same block, and
+ * interning or flushing one of them would free it under the other.
+ */
+void bgp_attr_ext_unshare(struct attr *attr)
+{
+	struct bgp_attr_ext *ext = attr->ext;
+
+	if (!ext || ext->refcnt)
+		return;
+
+	attr->ext = XMALLOC(MTYPE_BGP_ATTR_EXT, sizeof(struct bgp_attr_ext));
+	*attr->ext = *ext;
+}
+
+/* Free the private extension block of a non-interned attr, if any. */
+void bgp_attr_ext_flush(struct attr *attr)
+{
+	if (attr->ext && !attr->ext->refcnt) {
+		attr_ext_free(attr->ext);
+		attr->ext = NULL;
+	}
+}
+
+static void *attr_ext_hash_alloc(void *p)
+{
+	return p;
+}
+
+/*
+ * Intern a private block.  A block holding only default values is dropped,
+ * so that attrs with and without one hash and compare alike.
+ */
+static struct bgp_attr_ext *attr_ext_intern(struct bgp_attr_ext *ext)
+{
+	struct bgp_attr_ext *find;
+
+	if (attr_ext_same(ext, &attr_ext_default)) {
+		attr_ext_free(ext);
+		return NULL;
+	}
+
+	find = hash_get(attr_ext_hash, ext, attr_ext_hash_alloc);
+	if (find != ext)
+		attr_ext_free(ext);
+	find->refcnt++;
+	return find;
+}
+
+static void attr_ext_unintern(struct bgp_attr_ext **extp)
+{
+	struct bgp_attr_ext *ext = *extp;
+
+	if (!ext)
+		return;
+
+	if (ext->refcnt)
+		ext->refcnt--;
+
+	if (ext->refcnt == 0) {
+		hash_release(attr_ext_hash, ext);
+		attr_ext_free(ext);
+		*extp = NULL;
+	}
+}
+
+static uint32_t attr_ext_hash_key_make(const void *p)
+{
+	const struct bgp_attr_ext *ext = p;
+	uint32_t key = 0;
+
+	key = jhash_3words(ext->mm_seqnum, ext->df_alg, ext->df_pref, key);
+	key = jhash_3words((uint32_t)ext->aigp_metric,
+			   (uint32_t)(ext->aigp_metric >> 32), ext->mm_sync_seqnum,
+			   key);
+	key = jhash_1word(ext->pmsi_tnl_type, key);
+	if (ext->pmsi_tnl_type == PMSI_TNLTYPE_INGR_REPL)
+		key = jhash(ext->tunn_id.s6_addr, IPV6_MAX_BYTELEN, key);
+	return key;
+}
+
+static bool attr_ext_hash_cmp(const void *p1, const void *p2)
+{
+	return attr_ext_same(p1, p2);
+}
+
+static void attr_ext_init(void)
+{
+	attr_ext_hash = hash_create(attr_ext_hash_key_make, attr_ext_hash_cmp,
+				    "BGP Attribute Extension");
+}
+
+static void attr_ext_finish(void)
+{
+	hash_clean_and_free(&attr_ext_hash, (void (*)(void *))attr_ext_free);
+}
+
 static bool bgp_nhc_same(const struct bgp_nhc *nhc1, const struct bgp_nhc *nhc2)
 {
 	const struct bgp_nhc_tlv *p;
@@ -1046,12 +1190,9 @@ unsigned int attrhash_key_make(const void *p)
 	key = jhash(attr->mp_nexthop_global.s6_addr, IPV6_MAX_BYTELEN, key);
 	key = jhash(attr->mp_nexthop_local.s6_addr, IPV6_MAX_BYTELEN, key);
 	MIX3(attr->nh_ifindex, attr->nh_lla_ifindex, attr->distance);
-	MIX3(attr->bh_type, attr->otc, bgp_attr_get_aigp_metric(attr));
-	MIX3(attr->mm_seqnum, attr->df_alg, attr->df_pref);
-	MIX(attr->encap_tunneltype);
-	MIX(bgp_attr_get_pmsi_tnl_type(attr));
-	if (bgp_attr_get_pmsi_tnl_type(attr) == PMSI_TNLTYPE_INGR_REPL)
-		key = jhash(attr->tunn_id.s6_addr, IPV6_MAX_BYTELEN, key);
+	MIX3(attr->bh_type, attr->otc, attr->encap_tunneltype);
+	if (!attr_ext_same(attr_ext(attr), &attr_ext_default))
+		MIX(attr_ext_hash_key_make(attr->ext));
 	key = jhash(&attr->rmac, sizeof(attr->rmac), key);
 	if (bgp_attr_get_nhc(attr))
 		MIX(bgp_nhc_hash_key_make(bgp_attr_get_nhc(attr)));
@@ -1082,7 +1223,6 @@ bool attrhash_cmp(const void *p1, const void *p2)
 		    bgp_attr_get_lcommunity(attr1) == bgp_attr_get_lcommunity(attr2) &&
 		    bgp_attr_get_cluster(attr1) == bgp_attr_get_cluster(attr2) &&
 		    bgp_attr_get_transit(attr1) == bgp_attr_get_transit(attr2) &&
-		    bgp_attr_get_aigp_metric(attr1) == bgp_attr_get_aigp_metric(attr2) &&
 		    attr1->rmap_table_id == attr2->rmap_table_id &&
 		    (attr1->encap_tunneltype == attr2->encap_tunneltype) &&
 		    encap_same(attr1->encap_subtlvs, attr2->encap_subtlvs)
@@ -1095,9 +1235,8 @@ bool attrhash_cmp(const void *p1, const void *p2)
 		    IPV4_ADDR_SAME(&attr1->originator_id, &attr2->originator_id) &&
 		    overlay_index_same(attr1, attr2) &&
 		    !memcmp(&attr1->esi, &attr2->esi, sizeof(esi_t)) &&
-		    attr1->es_flags == attr2->es_flags && attr1->mm_seqnum == attr2->mm_seqnum &&
-		    attr1->mm_sync_seqnum == attr2->mm_sync_seqnum &&
-		    attr1->df_pref == attr2->df_pref && attr1->df_alg == attr2->df_alg &&
+		    attr1->es_flags == attr2->es_flags &&
+		    attr_ext_same(attr_ext(attr1), attr_ext(attr2)) &&
 		    attr1->nh_ifindex == attr2->nh_ifindex &&
 		    attr1->nh_lla_ifindex == attr2->nh_lla_ifindex &&
 		    attr1->nh_flags == attr2->nh_flags && attr1->distance == attr2->distance &&
@@ -1107,9 +1246,7 @@ bool attrhash_cmp(const void *p1, const void *p2)
 		    attr1->bh_type == attr2->bh_type && attr1->otc == attr2->otc &&
 		    !memcmp(&attr1->rmac, &attr2->rmac, sizeof(struct ethaddr)) &&
 		    bgp_nhc_same(bgp_attr_get_nhc(attr1), bgp_attr_get_nhc(attr2)) &&
-		    bgp_ls_attr_same(attr1->ls_attr, attr2->ls_attr) &&
-		    (attr1->pmsi_tnl_type == attr2->pmsi_tnl_type) &&
-		    IPV6_ADDR_SAME(&attr1->tunn_id, &attr2->tunn_id))
+		    bgp_ls_attr_same(attr1->ls_attr, attr2->ls_attr))
 			return true;
 	}
 
@@ -1166,7 +1303,7 @@ static void attr_show_all_iterator(struct hash_bucket *bucket, void *args[])
 		" distance: %u med: %u local_pref: %u origin: %u weight: %u label: %u sid: %pI6 aigp_metric: %" PRIu64
 		"\n",
 		attr->flag, attr->distance, attr->med, attr->local_pref,
-		attr->origin, attr->weight, attr->label, sid, attr->aigp_metric);
+		attr->origin, attr->weight, attr->label, sid, bgp_attr_get_aigp_metric(attr));
 	vty_out(vty,
 		"\tnh_ifindex: %u nh_flags: %u distance: %u nexthop_global: %pI6 nexthop_local: %pI6 nexthop_local_ifindex: %u\n",
 		attr->nh_ifindex, attr->nh_flags, attr->distance, &attr->mp_nexthop_global,
@@ -1240,18 +1377,17 @@ static void *bgp_attr_hash_alloc(void *p)
 	return attr;
 }
 
-/* Internet argument attribute. */
-struct attr *bgp_attr_intern(struct attr *attr)
+/* Intern the structures referenced by attr, or take another reference on
+ * the ones that already are.
+ */
+static void bgp_attr_intern_sub(struct attr *attr)
 {
-	struct attr *find;
 	struct ecommunity *ecomm = NULL;
 	struct ecommunity *ipv6_ecomm = NULL;
 	struct lcommunity *lcomm = NULL;
 	struct community *comm = NULL;
 	struct bgp_route_evpn *bre = NULL;
-	struct attr *reuse_anchor = attr->attr_intern_reuse.parsed_attr;
 
-	/* Intern referenced structure. */
 	if (attr->aspath) {
 		if (!attr->aspath->refcnt)
 			attr->aspath = aspath_intern(attr->aspath);
@@ -1326,6 +1462,13 @@ struct attr *bgp_attr_intern(struct attr *attr)
 			bre->refcnt++;
 	}
 
+	if (attr->ext) {
+		if (!attr->ext->refcnt)
+			attr->ext = attr_ext_intern(attr->ext);
+		else
+			attr->ext->refcnt++;
+	}
+
 	if (attr->srv6_l3service) {
 		if (!attr->srv6_l3service->refcnt)
 			attr->srv6_l3service = bgp_attr_srv6_l3service_intern(attr->srv6_l3service);
@@ -1367,6 +1510,16 @@ struct attr *bgp_attr_intern(struct attr *attr)
 		else
 			attr->ls_attr->refcnt++;
 	}
+}
+
+/* Internet argument attribute. */
+struct attr *bgp_attr_intern(struct attr *attr)
+{
+	struct attr *find;
+	struct attr *reuse_anchor = attr->attr_intern_reuse.parsed_attr;
+
+	/* Intern referenced structure. */
+	bgp_attr_intern_sub(attr);
 
 	/* At this point, attr only contains intern'd pointers.  that means
 	 * if we find it in attrhash, it has all the same pointers and we
@@ -1401,6 +1554,57 @@ struct attr *bgp_attr_intern(struct attr *attr)
 	return find;
 }
 
+/*
+ * Take another reference on an attribute that is already interned.  Same
+ * result as bgp_attr_intern(), but skips hashing and comparing the whole
+ * attribute just to find itself in attrhash.
+ */
+struct attr *bgp_attr_intern_ref(struct attr *attr)
+{
+	assert(attr->refcnt);
+
+	bgp_attr_intern_sub(attr);
+	attr->refcnt++;
+
+	return attr;
+}
+
+/* Does attr only reference interned sub-objects?  A shallow copy of such
+ * an attr can be interned without taking over anything attr owns.
+ */
+bool bgp_attr_subs_interned(const struct attr *attr)
+{
+	const struct community *comm = bgp_attr_get_community(attr);
+	const struct ecommunity *ecomm = bgp_attr_get_ecommunity(attr);
+	const struct ecommunity *ipv6_ecomm = bgp_attr_get_ipv6_ecommunity(attr);
+	const struct lcommunity *lcomm = bgp_attr_get_lcommunity(attr);
+	const struct cluster_list *cluster = bgp_attr_get_cluster(attr);
+	const struct transit *transit = bgp_attr_get_transit(attr);
+	const struct bgp_route_evpn *bre = bgp_attr_get_evpn_overlay(attr);
+	const struct bgp_nhc *nhc = bgp_attr_get_nhc(attr);
+#ifdef ENABLE_BGP_VNC
+	const struct bgp_attr_encap_subtlv *vnc_subtlvs =
+		bgp_attr_get_vnc_subtlvs(attr);
+
+	if (vnc_subtlvs && !vnc_subtlvs->refcnt)
+		return false;
+#endif
+
+	if ((attr->aspath && !attr->aspath->refcnt) ||
+	    (comm && !comm->refcnt) || (ecomm && !ecomm->refcnt) ||
+	    (ipv6_ecomm && !ipv6_ecomm->refcnt) ||
+	    (lcomm && !lcomm->refcnt) || (cluster && !cluster->refcnt) ||
+	    (transit && !transit->refcnt) ||
+	    (attr->encap_subtlvs && !attr->encap_subtlvs->refcnt) ||
+	    (bre && !bre->refcnt) || (attr->ext && !attr->ext->refcnt) ||
+	    (attr->srv6_l3service && !attr->srv6_l3service->refcnt) ||
+	    (attr->srv6_vpn && !attr->srv6_vpn->refcnt) ||
+	    (nhc && !nhc->refcnt) || (attr->ls_attr && !attr->ls_attr->refcnt))
+		return false;
+
+	return true;
+}
+
 /* Make network statement's attribute. */
 struct attr *bgp_attr_default_set(struct attr *attr, struct bgp *bgp,
 				  uint8_t origin)
@@ -1602,6 +1806,8 @@ void bgp_attr_unintern_sub(struct attr *attr)
 	evpn_overlay_unintern(&bre);
 	bgp_attr_set_evpn_overlay(attr, NULL);
 
+	attr_ext_unintern(&attr->ext);
+
 	bgp_ls_attr_unintern(&attr->ls_attr);
 }
 
@@ -1712,6 +1918,8 @@ void bgp_attr_flush(struct attr *attr)
 		bgp_attr_set_evpn_overlay(attr, NULL);
 	}
 
+	bgp_attr_ext_flush(attr);
+
 	nhc = bgp_attr_get_nhc(attr);
 	if (nhc && !nhc->refcnt) {
 		bgp_nhc_free(nhc);
@@ -3022,6 +3230,8 @@ bgp_attr_ext_communities(struct bgp_attr_parser_args *args)
 	bool proxy = false;
 	struct ecommunity *ecomm;
 	bgp_encap_types tun_type = BGP_ENCAP_TYPE_VXLAN;/*Default tunnel type*/
+	uint16_t df_pref;
+	uint8_t df_alg;
 
 	if (length == 0) {
 		bgp_attr_set_ecommunity(attr, NULL);
@@ -3044,10 +3254,11 @@ bgp_attr_ext_communities(struct bgp_attr_parser_args *args)
 					  args->total);
 
 	/* Extract DF election preference and  mobility sequence number */
-	attr->df_pref = bgp_attr_df_pref_from_ec(attr, &attr->df_alg);
+	df_pref = bgp_attr_df_pref_from_ec(attr, &df_alg);
+	bgp_attr_set_df(attr, df_alg, df_pref);
 
 	/* Extract MAC mobility sequence number, if any. */
-	attr->mm_seqnum = bgp_attr_mac_mobility_seqnum(attr);
+	bgp_attr_set_mm_seqnum(attr, bgp_attr_mac_mobility_seqnum(attr));
 
 	/* Check if this is a Gateway MAC-IP advertisement */
 	bgp_attr_default_gw(attr);
@@ -3078,10 +3289,6 @@ bgp_attr_ext_communities(struct bgp_attr_parser_args *args)
 	bgp_attr_extcom_tunnel_type(attr, &tun_type);
 	attr->encap_tunneltype = tun_type;
 
-	/* Extract link bandwidth, if any. */
-	(void)ecommunity_linkbw_present(bgp_attr_get_ecommunity(attr),
-					&attr->link_bw);
-
 	return BGP_ATTR_PARSE_PROCEED;
 }
 
@@ -3114,10 +3321,6 @@ bgp_attr_ipv6_ext_communities(struct bgp_attr_parser_args *args)
 		return bgp_attr_malformed(args, BGP_NOTIFY_UPDATE_OPT_ATTR_ERR,
 					  args->total);
 
-	/* Extract link bandwidth, if any. */
-	(void)ecommunity_linkbw_present(bgp_attr_get_ipv6_ecommunity(attr),
-					&attr->link_bw);
-
 	return BGP_ATTR_PARSE_PROCEED;
 
 ipv6_ext_community_ignore:
@@ -3745,6 +3948,7 @@ bgp_attr_pmsi_tunnel(struct bgp_attr_parser_args *args)
 	uint8_t tnl_type;
 	int attr_parse_len = 2 + BGP_LABEL_BYTES;
 	struct in_addr tunn_id;
+	struct in6_addr tunn_id6;
 
 	if (peer->discard_attrs[args->type] || peer->withdraw_attrs[args->type])
 		goto pmsi_tunnel_ignore;
@@ -3790,12 +3994,13 @@ bgp_attr_pmsi_tunnel(struct bgp_attr_parser_args *args)
 	if (tnl_type == PMSI_TNLTYPE_INGR_REPL) {
 		if (length == BGP_ATTR_PMSI_TUNNEL_V4_LENGTH) {
 			tunn_id.s_addr = stream_get_ipv4(connection->curr);
-			ipv4_to_ipv4_mapped_ipv6(&attr->tunn_id, tunn_id);
+			ipv4_to_ipv4_mapped_ipv6(&tunn_id6, tunn_id);
 			attr_parse_len += IPV4_MAX_BYTELEN;
 		} else {
-			stream_get(&attr->tunn_id, connection->curr, IPV6_MAX_BYTELEN);
+			stream_get(&tunn_id6, connection->curr, IPV6_MAX_BYTELEN);
 			attr_parse_len += IPV6_MAX_BYTELEN;
 		}
+		bgp_attr_set_pmsi_tunn_id(attr, &tunn_id6);
 	}
 
 	/* Forward read pointer of input stream to skip anything we didn't parse */
@@ -4658,6 +4863,8 @@ done:
 		if (attr->encap_subtlvs)
 			attr->encap_subtlvs = encap_intern(attr->encap_subtlvs,
 							   ENCAP_SUBTLV_TYPE);
+		if (attr->ext)
+			attr->ext = attr_ext_intern(attr->ext);
 #ifdef ENABLE_BGP_VNC
 		struct bgp_attr_encap_subtlv *vnc_subtlvs =
 			bgp_attr_get_vnc_subtlvs(attr);
@@ -4674,6 +4881,11 @@ done:
 		}
 
 		bgp_attr_flush_encap(attr);
+
+		if (attr->ext) {
+			attr_ext_free(attr->ext);
+			attr->ext = NULL;
+		}
 	};
 
 	/* Sanity checks */
@@ -4682,6 +4894,8 @@ done:
 		assert(transit->refcnt > 0);
 	if (attr->encap_subtlvs)
 		assert(attr->encap_subtlvs->refcnt > 0);
+	if (attr->ext)
+		assert(attr->ext->refcnt > 0);
 #ifdef ENABLE_BGP_VNC
 	struct bgp_attr_encap_subtlv *vnc_subtlvs =
 		bgp_attr_get_vnc_subtlvs(attr);
@@ -5696,23 +5910,24 @@ bgp_size_t bgp_packet_attribute(struct bgp *bgp, struct peer *peer, struct strea
 	/* PMSI Tunnel */
 	if (bgp_attr_exists(attr, BGP_ATTR_PMSI_TUNNEL)) {
 		uint8_t tunn_id_len = 0;
-		uint8_t *nh;
+		const uint8_t *nh;
 		struct in_addr tunn_id;
+		const struct in6_addr *pmsi_tunn_id = bgp_attr_get_pmsi_tunn_id(attr);
 
 		stream_putc(s, BGP_ATTR_FLAG_OPTIONAL | BGP_ATTR_FLAG_TRANS);
 		stream_putc(s, BGP_ATTR_PMSI_TUNNEL);
 
 		/* Encode tunnel id for known tunnel type */
 		if (bgp_attr_get_pmsi_tnl_type(attr) == PMSI_TNLTYPE_INGR_REPL) {
-			if (IS_MAPPED_IPV6(&attr->tunn_id)) {
+			if (IS_MAPPED_IPV6(pmsi_tunn_id)) {
 				stream_putc(s, BGP_ATTR_PMSI_TUNNEL_V4_LENGTH);
 				tunn_id_len = IPV4_MAX_BYTELEN;
-				ipv4_mapped_ipv6_to_ipv4(&attr->tunn_id, &tunn_id);
-				nh = (uint8_t *)&tunn_id;
+				ipv4_mapped_ipv6_to_ipv4(pmsi_tunn_id, &tunn_id);
+				nh = (const uint8_t *)&tunn_id;
 			} else {
 				stream_putc(s, BGP_ATTR_PMSI_TUNNEL_V6_LENGTH);
 				tunn_id_len = IPV6_MAX_BYTELEN;
-				nh = (uint8_t *)&attr->tunn_id;
+				nh = pmsi_tunn_id->s6_addr;
 			}
 		} else {
 			/* Encode label part only */
@@ -5747,7 +5962,7 @@ bgp_size_t bgp_packet_attribute(struct bgp *bgp, struct peer *peer, struct strea
 		stream_putc(s, BGP_ATTR_FLAG_OPTIONAL);
 		stream_putc(s, BGP_ATTR_AIGP);
 		stream_putc(s, attr_len);
-		stream_put_bgp_aigp_tlv_metric(s, attr->aigp_metric);
+		stream_put_bgp_aigp_tlv_metric(s, bgp_attr_get_aigp_metric(attr));
 	}
 
 	/* BGP-LS Attribute (Type 29) - RFC 9552 Section 4 */
@@ -5830,6 +6045,7 @@ void bgp_attr_init(void)
 	encap_init();
 	srv6_init();
 	evpn_overlay_init();
+	attr_ext_init();
 	nhc_init();
 }
 
@@ -5845,6 +6061,7 @@ void bgp_attr_finish(void)
 	encap_finish();
 	srv6_finish();
 	evpn_overlay_finish();
+	attr_ext_finish();
 	nhc_finish();
 }
 
@@ -6029,7 +6246,7 @@ void bgp_dump_routes_attr(struct stream *s, struct bgp_path_info *bpi,
 		stream_putc(s, BGP_ATTR_FLAG_OPTIONAL | BGP_ATTR_FLAG_TRANS);
 		stream_putc(s, BGP_ATTR_AIGP);
 		stream_putc(s, attr_len);
-		stream_put_bgp_aigp_tlv_metric(s, attr->aigp_metric);
+		stream_put_bgp_aigp_tlv_metric(s, bgp_attr_get_aigp_metric(attr));
 	}
 
 	/* Return total size of attribute. */
@@ -124,6 +124,37 @@ struct bgp_attr_srv6_vpn {
 	struct in6_addr sid;
 };
 
+/*
+ * Attributes that only EVPN, multicast VPN or AIGP speakers ever set.
+ * They are kept out of struct attr so that plain unicast routes neither
+ * carry nor compare them; a route either has no block at all or points to
+ * an interned one shared by every attr with the same values.
+ */
+struct bgp_attr_ext {
+	unsigned long refcnt;
+
+	/* AIGP Metric */
+	uint64_t aigp_metric;
+
+	/* PMSI tunnel type (RFC 6514). */
+	enum pta_type pmsi_tnl_type;
+	struct in6_addr tunn_id; /* PMSI Tunnel Id */
+
+	/* EVPN MAC Mobility sequence number, if any. */
+	uint32_t mm_seqnum;
+	/* highest MM sequence number rxed in a MAC-IP route from an
+	 * ES peer (this includes both proxy and non-proxy MAC-IP
+	 * advertisements from ES peers).
+	 * This is only applicable to local paths in the VNI routing
+	 * table and derived from other imported/non-best paths.
+	 */
+	uint32_t mm_sync_seqnum;
+
+	/* EVPN DF preference for DF election on local ESs */
+	uint16_t df_pref;
+	uint8_t df_alg;
+};
+
 /* BGP core attribute structure. */
 struct attr {
 	/* AS Path structure */
@@ -188,8 +219,6 @@ struct attr {
 	/* Distance as applied by Route map */
 	uint8_t distance;
 
-	uint8_t df_alg;
-
 	/* EVPN flags */
 	uint8_t evpn_flags;
 #define ATTR_EVPN_FLAG_STICKY	  (1 << 0)
@@ -210,20 +239,16 @@ struct attr {
 
 		/* parsed attr pointer for equality check */
 		struct attr *parsed_attr;
-	} attr_intern_reuse;
 
-	/* EVPN DF preference for DF election on local ESs */
-	uint16_t df_pref;
+		/* inbound route-map results for the prefixes of the UPDATE */
+		struct bgp_rmap_memo *rmap_memo;
+	} attr_intern_reuse;
 
 	/* MP Nexthop length */
 	uint8_t mp_nexthop_len;
 
 	uint16_t encap_tunneltype;
 
-	/* PMSI tunnel type (RFC 6514). */
-	enum pta_type pmsi_tnl_type;
-	struct in6_addr tunn_id; /* PMSI Tunnel Id */
-
 	/* Multi-Protocol Nexthop, AFI IPv6 */
 	struct in6_addr mp_nexthop_global;
 	struct in6_addr mp_nexthop_local;
@@ -286,22 +311,12 @@ struct attr {
 	/* EVPN */
 	struct bgp_route_evpn *evpn_overlay;
 
-	/* EVPN MAC Mobility sequence number, if any. */
-	uint32_t mm_seqnum;
-	/* highest MM sequence number rxed in a MAC-IP route from an
-	 * ES peer (this includes both proxy and non-proxy MAC-IP
-	 * advertisements from ES peers).
-	 * This is only applicable to local paths in the VNI routing
-	 * table and derived from other imported/non-best paths.
-	 */
-	uint32_t mm_sync_seqnum;
+	/* AIGP, PMSI tunnel and EVPN MAC mobility / DF election */
+	struct bgp_attr_ext *ext;
 
 	/* EVPN local router-mac */
 	struct ethaddr rmac;
 
-	/* Link bandwidth value, if any. */
-	uint64_t link_bw;
-
 	/* EVPN ES */
 	esi_t esi;
 
@@ -317,9 +332,6 @@ struct attr {
 	/* OTC value if set */
 	uint32_t otc;
 
-	/* AIGP Metric */
-	uint64_t aigp_metric;
-
 	/* Next-hop characteristics */
 	struct bgp_nhc *nhc;
 
@@ -393,6 +405,8 @@ extern enum bgp_attr_parse_ret
 bgp_attr_parse(struct peer *peer, struct attr *attr, bgp_size_t size,
 	       struct bgp_nlri *mp_update, struct bgp_nlri *mp_withdraw);
 extern struct attr *bgp_attr_intern(struct attr *attr);
+extern struct attr *bgp_attr_intern_ref(struct attr *attr);
+extern bool bgp_attr_subs_interned(const struct attr *attr);
 extern struct bgp_attr_srv6_l3service *
 bgp_attr_srv6_l3service_intern(struct bgp_attr_srv6_l3service *vpn);
 extern void bgp_attr_srv6_l3service_free(struct bgp_attr_srv6_l3service *vpn);
@@ -491,6 +505,10 @@ extern enum bgp_attr_parse_ret bgp_attr_nexthop_valid(struct peer *peer,
 
 extern uint32_t bgp_attr_get_color(struct attr *attr);
 
+extern struct bgp_attr_ext *bgp_attr_ext_get(struct attr *attr);
+extern void bgp_attr_ext_unshare(struct attr *attr);
+extern void bgp_attr_ext_flush(struct attr *attr);
+
 static inline bool bgp_rmap_nhop_changed(uint32_t out_rmap_flags)
 {
 	return ((CHECK_FLAG(out_rmap_flags, BATTR_RMAP_NEXTHOP_PEER_ADDRESS) ||
@@ -507,18 +525,68 @@ static inline bool bgp_rmap_nhop_changed(uint32_t out_rmap_flags)
 
 static inline uint32_t mac_mobility_seqnum(struct attr *attr)
 {
-	return (attr) ? attr->mm_seqnum : 0;
+	return (attr && attr->ext) ? attr->ext->mm_seqnum : 0;
+}
+
+static inline void bgp_attr_set_mm_seqnum(struct attr *attr, uint32_t seq)
+{
+	if (mac_mobility_seqnum(attr) != seq)
+		bgp_attr_ext_get(attr)->mm_seqnum = seq;
+}
+
+static inline void bgp_attr_set_mm_sync_seqnum(struct attr *attr, uint32_t seq)
+{
+	if ((attr->ext ? attr->ext->mm_sync_seqnum : 0) != seq)
+		bgp_attr_ext_get(attr)->mm_sync_seqnum = seq;
+}
+
+static inline uint16_t bgp_attr_get_df_pref(const struct attr *attr)
+{
+	return attr->ext ? attr->ext->df_pref : 0;
+}
+
+static inline uint8_t bgp_attr_get_df_alg(const struct attr *attr)
+{
+	return attr->ext ? attr->ext->df_alg : 0;
+}
+
+static inline void bgp_attr_set_df(struct attr *attr, uint8_t df_alg,
+				   uint16_t df_pref)
+{
+	struct bgp_attr_ext *ext;
+
+	if (bgp_attr_get_df_alg(attr) == df_alg &&
+	    bgp_attr_get_df_pref(attr) == df_pref)
+		return;
+
+	ext = bgp_attr_ext_get(attr);
+	ext->df_alg = df_alg;
+	ext->df_pref = df_pref;
 }
 
 static inline enum pta_type bgp_attr_get_pmsi_tnl_type(const struct attr *attr)
 {
-	return attr->pmsi_tnl_type;
+	return attr->ext ? attr->ext->pmsi_tnl_type : PMSI_TNLTYPE_NO_INFO;
 }
 
 static inline void bgp_attr_set_pmsi_tnl_type(struct attr *attr,
 					      enum pta_type pmsi_tnl_type)
 {
-	attr->pmsi_tnl_type = pmsi_tnl_type;
+	if (bgp_attr_get_pmsi_tnl_type(attr) != pmsi_tnl_type)
+		bgp_attr_ext_get(attr)->pmsi_tnl_type = pmsi_tnl_type;
+}
+
+static inline const struct in6_addr *
+bgp_attr_get_pmsi_tunn_id(const struct attr *attr)
+{
+	return attr->ext ? &attr->ext->tunn_id : &in6addr_any;
+}
+
+static inline void bgp_attr_set_pmsi_tunn_id(struct attr *attr,
+					     const struct in6_addr *tunn_id)
+{
+	if (!IPV6_ADDR_SAME(bgp_attr_get_pmsi_tunn_id(attr), tunn_id))
+		bgp_attr_ext_get(attr)->tunn_id = *tunn_id;
 }
 
 static inline struct ecommunity *
@@ -623,12 +691,13 @@ static inline void bgp_attr_set_nhc(struct attr *attr, struct bgp_nhc *bnc)
 
 static inline uint64_t bgp_attr_get_aigp_metric(const struct attr *attr)
 {
-	return attr->aigp_metric;
+	return attr->ext ? attr->ext->aigp_metric : 0;
 }
 
 static inline void bgp_attr_set_aigp_metric(struct attr *attr, uint64_t aigp)
 {
-	attr->aigp_metric = aigp;
+	if (bgp_attr_get_aigp_metric(attr) != aigp)
+		bgp_attr_ext_get(attr)->aigp_metric = aigp;
 	SET_FLAG(attr->flag, ATTR_FLAG_BIT(BGP_ATTR_AIGP));
 }
 
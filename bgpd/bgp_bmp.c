@@ -1313,12 +1313,18 @@ static void bmp_eor_afi_safi(struct bmp *bmp, afi_t afi, safi_t safi, uint8_t pe
 	bmp->sync_bgp = sync_bgp;
 }
 
+/* prefixes without anything to send that a single bmp_wrsync() call may
+ * step over; past this, the walk resumes from syncpos on the next run
+ */
+#define BMP_SYNC_SKIP_MAX 1000
+
 static bool bmp_wrsync(struct bmp *bmp, struct pullwr *pullwr)
 {
 	uint8_t bpi_num_labels, adjin_num_labels;
 	afi_t afi;
 	safi_t safi;
 	uint8_t peer_type_flag;
+	unsigned int skipped = 0;
 
 	if (bmp->syncafi == AFI_MAX) {
 		FOREACH_AFI_SAFI (afi, safi) {
@@ -1464,7 +1470,16 @@ afibreak:
 		if (bpi || adjin)
 			break;
 
+		bgp_dest_unlock_node(bn);
 		bn = NULL;
+
+		/* nothing to send from this run of prefixes, let the main
+		 * loop have a go before walking on from syncpos
+		 */
+		if (++skipped >= BMP_SYNC_SKIP_MAX) {
+			pullwr_bump(bmp->pullwr);
+			return false;
+		}
 	} while (1);
 
 	if (adjin && bpi
@@ -96,9 +96,21 @@ community_list_master_lookup(struct community_list_handler *ch, int master)
 	return NULL;
 }
 
+/* Generation of the community-list configuration.  Every entry add or
+ * delete and every community alias change bumps it, which invalidates all
+ * expanded entry results cached on interned communities at once.
+ */
+static uint32_t community_list_gen;
+
+void community_list_cache_flush(void)
+{
+	community_list_gen++;
+}
+
 /* Allocate a new community list entry.  */
 static struct community_entry *community_entry_new(void)
 {
+	community_list_cache_flush();
 	return XCALLOC(MTYPE_COMMUNITY_LIST_ENTRY,
 		       sizeof(struct community_entry));
 }
@@ -106,6 +118,8 @@ static struct community_entry *community_entry_new(void)
 /* Free community list entry.  */
 static void community_entry_free(struct community_entry *entry)
 {
+	community_list_cache_flush();
+
 	switch (entry->style) {
 	case COMMUNITY_LIST_STANDARD:
 		if (entry->u.com)
@@ -691,18 +705,258 @@ static bool ecommunity_regexp_match(struct ecommunity *ecom, struct frregex *reg
 	return false;
 }
 
+/* Number of expanded entry results kept per interned community.  */
+#define COMMUNITY_LIST_CACHE_SIZE 8
+
+/* Hung off interned community, large-community and extcommunity values,
+ * which are immutable, so that matching the same value against the same
+ * lists for route after route does not redo the work.
+ */
+struct community_list_cache {
+	/* community_list_gen the results below are valid for.  */
+	uint32_t gen;
+
+	/* Values are in ascending order, see community_list_subset().  */
+	bool sorted;
+
+	uint8_t count;
+	uint8_t next;
+
+	/* Expanded entry results, keyed by the entry's regex.  */
+	struct {
+		const struct frregex *reg;
+		bool match;
+	} res[COMMUNITY_LIST_CACHE_SIZE];
+};
+
+static struct community_list_cache *
+community_list_cache_get(struct community_list_cache **cachep,
+			 unsigned long refcnt, const uint8_t *val, int size,
+			 size_t unit)
+{
+	struct community_list_cache *cache = *cachep;
+	int i;
+
+	/* Values that are not interned may still be modified. */
+	if (!refcnt)
+		return NULL;
+
+	if (!cache) {
+		cache = XCALLOC(MTYPE_COMMUNITY_LIST_CACHE, sizeof(*cache));
+		cache->gen = community_list_gen;
+		cache->sorted = true;
+		for (i = 1; i < size; i++) {
+			if (memcmp(val + (i - 1) * unit, val + i * unit,
+				   unit) > 0) {
+				cache->sorted = false;
+				break;
+			}
+		}
+		*cachep = cache;
+	} else if (cache->gen != community_list_gen) {
+		cache->gen = community_list_gen;
+		cache->count = 0;
+		cache->next = 0;
+	}
+
+	return cache;
+}
+
+/* Cached result of an expanded entry, or -1 if there is none.  */
+static int community_list_cache_lookup(const struct community_list_cache *cache,
+				       const struct frregex *reg)
+{
+	int i;
+
+	if (!cache)
+		return -1;
+
+	for (i = 0; i < cache->count; i++)
+		if (cache->res[i].reg == reg)
+			return cache->res[i].match;
+
+	return -1;
+}
+
+static bool community_list_cache_store(struct community_list_cache *cache,
+				       const struct frregex *reg, bool match)
+{
+	if (!cache)
+		return match;
+
+	cache->res[cache->next].reg = reg;
+	cache->res[cache->next].match = match;
+	cache->next = (cache->next + 1) % COMMUNITY_LIST_CACHE_SIZE;
+	if (cache->count < COMMUNITY_LIST_CACHE_SIZE)
+		cache->count++;
+
+	return match;
+}
+
+/* Is every value in sub also in set?  Values are unit bytes wide and
+ * compared with memcmp(), which is numeric order for all three community
+ * types; set must be sorted.  Entries usually hold one or two values
+ * against a route's dozens, so rather than walking set linearly each
+ * lookup gallops forward from the previous hit and then bisects.  For a
+ * sorted set this gives the same answer as the linear walk in
+ * community_match() and friends.
+ */
+static bool community_list_subset(const uint8_t *set, int size,
+				  const uint8_t *sub, int subsize, size_t unit)
+{
+	const uint8_t *v;
+	int lo = 0, hi, mid, step;
+	int i;
+
+	if (size < subsize)
+		return false;
+
+	for (i = 0; i < subsize; i++) {
+		v = sub + i * unit;
+
+		step = 1;
+		hi = lo;
+		while (hi < size && memcmp(set + hi * unit, v, unit) < 0) {
+			lo = hi + 1;
+			hi += step;
+			step <<= 1;
+		}
+		if (hi > size)
+			hi = size;
+
+		while (lo < hi) {
+			mid = lo + (hi - lo) / 2;
+			if (memcmp(set + mid * unit, v, unit) < 0)
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+
+		if (lo >= size || memcmp(set + lo * unit, v, unit) != 0)
+			return false;
+		lo++;
+	}
+
+	return true;
+}
+
+static struct community_list_cache *community_cache(struct community *com)
+{
+	if (!com)
+		return NULL;
+
+	return community_list_cache_get(&com->clist, com->refcnt,
+					(const uint8_t *)com->val, com->size,
+					COMMUNITY_SIZE);
+}
+
+static struct community_list_cache *lcommunity_cache(struct lcommunity *lcom)
+{
+	if (!lcom)
+		return NULL;
+
+	return community_list_cache_get(&lcom->clist, lcom->refcnt, lcom->val,
+					lcom->size, LCOMMUNITY_SIZE);
+}
+
+static struct community_list_cache *ecommunity_cache(struct ecommunity *ecom)
+{
+	if (!ecom)
+		return NULL;
+
+	return community_list_cache_get(&ecom->clist, ecom->refcnt, ecom->val,
+					ecom->size, ecom->unit_size);
+}
+
+static bool community_entry_match(struct community *com,
+				  struct community_list_cache *cache,
+				  struct community *ecom)
+{
+	if (cache && cache->sorted && ecom)
+		return community_list_subset((const uint8_t *)com->val,
+					     com->size,
+					     (const uint8_t *)ecom->val,
+					     ecom->size, COMMUNITY_SIZE);
+
+	return community_match(com, ecom);
+}
+
+static bool lcommunity_entry_match(struct lcommunity *lcom,
+				   struct community_list_cache *cache,
+				   struct lcommunity *elcom)
+{
+	if (cache && cache->sorted && elcom)
+		return community_list_subset(lcom->val, lcom->size, elcom->val,
+					     elcom->size, LCOMMUNITY_SIZE);
+
+	return lcommunity_match(lcom, elcom);
+}
+
+static bool ecommunity_entry_match(struct ecommunity *ecom,
+				   struct community_list_cache *cache,
+				   struct ecommunity *eecom)
+{
+	if (cache && cache->sorted && eecom &&
+	    ecom->unit_size == eecom->unit_size)
+		return community_list_subset(ecom->val, ecom->size, eecom->val,
+					     eecom->size, ecom->unit_size);
+
+	return ecommunity_match(ecom, eecom);
+}
+
+static bool community_regexp_match_cached(struct community *com,
+					  struct community_list_cache *cache,
+					  struct frregex *reg)
+{
+	int ret = community_list_cache_lookup(cache, reg);
+
+	if (ret >= 0)
+		return ret;
+
+	return community_list_cache_store(cache, reg,
+					  community_regexp_match(com, reg));
+}
+
+static bool lcommunity_regexp_match_cached(struct lcommunity *lcom,
+					   struct community_list_cache *cache,
+					   struct frregex *reg)
+{
+	int ret = community_list_cache_lookup(cache, reg);
+
+	if (ret >= 0)
+		return ret;
+
+	return community_list_cache_store(cache, reg,
+					  lcommunity_regexp_match(lcom, reg));
+}
+
+static bool ecommunity_regexp_match_cached(struct ecommunity *ecom,
+					   struct community_list_cache *cache,
+					   struct frregex *reg)
+{
+	int ret = community_list_cache_lookup(cache, reg);
+
+	if (ret >= 0)
+		return ret;
+
+	return community_list_cache_store(cache, reg,
+					  ecommunity_regexp_match(ecom, reg));
+}
+
 /* When given community attribute matches to the community-list return
    1 else return 0.  */
 bool community_list_match(struct community *com, struct community_list *list)
 {
+	struct community_list_cache *cache = community_cache(com);
 	struct community_entry *entry;
 
 	for (entry = list->head; entry; entry = entry->next) {
 		if (entry->style == COMMUNITY_LIST_STANDARD) {
-			if (community_match(com, entry->u.com))
+			if (community_entry_match(com, cache, entry->u.com))
 				return entry->direct == COMMUNITY_PERMIT;
 		} else if (entry->style == COMMUNITY_LIST_EXPANDED) {
-			if (community_regexp_match(com, entry->reg))
+			if (community_regexp_match_cached(com, cache,
+							  entry->reg))
 				return entry->direct == COMMUNITY_PERMIT;
 		}
 	}
@@ -711,14 +965,16 @@ bool community_list_match(struct community *com, struct community_list *list)
 
 bool lcommunity_list_match(struct lcommunity *lcom, struct community_list *list)
 {
+	struct community_list_cache *cache = lcommunity_cache(lcom);
 	struct community_entry *entry;
 
 	for (entry = list->head; entry; entry = entry->next) {
 		if (entry->style == LARGE_COMMUNITY_LIST_STANDARD) {
-			if (lcommunity_match(lcom, entry->u.lcom))
+			if (lcommunity_entry_match(lcom, cache, entry->u.lcom))
 				return entry->direct == COMMUNITY_PERMIT;
 		} else if (entry->style == LARGE_COMMUNITY_LIST_EXPANDED) {
-			if (lcommunity_regexp_match(lcom, entry->reg))
+			if (lcommunity_regexp_match_cached(lcom, cache,
+							   entry->reg))
 				return entry->direct == COMMUNITY_PERMIT;
 		}
 	}
@@ -730,6 +986,7 @@ bool lcommunity_list_match(struct lcommunity *lcom, struct community_list *list)
  */
 bool ecommunity_list_exact_match(struct ecommunity *ecom, struct community_list *list)
 {
+	struct community_list_cache *cache = ecommunity_cache(ecom);
 	struct community_entry *entry;
 
 	for (entry = list->head; entry; entry = entry->next) {
@@ -737,7 +994,8 @@ bool ecommunity_list_exact_match(struct ecommunity *ecom, struct community_list
 			if (ecommunity_cmp(ecom, entry->u.lcom))
 				return entry->direct == COMMUNITY_PERMIT;
 		} else if (entry->style == EXTCOMMUNITY_LIST_EXPANDED) {
-			if (ecommunity_regexp_match(ecom, entry->reg))
+			if (ecommunity_regexp_match_cached(ecom, cache,
+							   entry->reg))
 				return entry->direct == COMMUNITY_PERMIT;
 		}
 	}
@@ -750,6 +1008,7 @@ bool ecommunity_list_exact_match(struct ecommunity *ecom, struct community_list
 bool lcommunity_list_exact_match(struct lcommunity *lcom,
 				 struct community_list *list)
 {
+	struct community_list_cache *cache = lcommunity_cache(lcom);
 	struct community_entry *entry;
 
 	for (entry = list->head; entry; entry = entry->next) {
@@ -757,7 +1016,8 @@ bool lcommunity_list_exact_match(struct lcommunity *lcom,
 			if (lcommunity_cmp(lcom, entry->u.lcom))
 				return entry->direct == COMMUNITY_PERMIT;
 		} else if (entry->style == LARGE_COMMUNITY_LIST_EXPANDED) {
-			if (lcommunity_regexp_match(lcom, entry->reg))
+			if (lcommunity_regexp_match_cached(lcom, cache,
+							   entry->reg))
 				return entry->direct == COMMUNITY_PERMIT;
 		}
 	}
@@ -766,14 +1026,16 @@ bool lcommunity_list_exact_match(struct lcommunity *lcom,
 
 bool ecommunity_list_match(struct ecommunity *ecom, struct community_list *list)
 {
+	struct community_list_cache *cache = ecommunity_cache(ecom);
 	struct community_entry *entry;
 
 	for (entry = list->head; entry; entry = entry->next) {
 		if (entry->style == EXTCOMMUNITY_LIST_STANDARD) {
-			if (ecommunity_match(ecom, entry->u.ecom))
+			if (ecommunity_entry_match(ecom, cache, entry->u.ecom))
 				return entry->direct == COMMUNITY_PERMIT;
 		} else if (entry->style == EXTCOMMUNITY_LIST_EXPANDED) {
-			if (ecommunity_regexp_match(ecom, entry->reg))
+			if (ecommunity_regexp_match_cached(ecom, cache,
+							   entry->reg))
 				return entry->direct == COMMUNITY_PERMIT;
 		}
 	}
@@ -785,6 +1047,7 @@ bool ecommunity_list_match(struct ecommunity *ecom, struct community_list *list)
 bool community_list_exact_match(struct community *com,
 				struct community_list *list)
 {
+	struct community_list_cache *cache = community_cache(com);
 	struct community_entry *entry;
 
 	for (entry = list->head; entry; entry = entry->next) {
@@ -792,7 +1055,8 @@ bool community_list_exact_match(struct community *com,
 			if (community_cmp(com, entry->u.com))
 				return entry->direct == COMMUNITY_PERMIT;
 		} else if (entry->style == COMMUNITY_LIST_EXPANDED) {
-			if (community_regexp_match(com, entry->reg))
+			if (community_regexp_match_cached(com, cache,
+							  entry->reg))
 				return entry->direct == COMMUNITY_PERMIT;
 		}
 	}
@@ -143,6 +143,8 @@ extern void lcommunity_list_unset(struct community_list_handler *ch,
 				  const char *name, const char *str,
 				  const char *seq, int direct, int style);
 
+extern void community_list_cache_flush(void);
+
 extern struct community_list_master *
 community_list_master_lookup(struct community_list_handler *ch, int master);
 
@@ -32,6 +32,7 @@ void community_free(struct community **com)
 
 	XFREE(MTYPE_COMMUNITY_VAL, (*com)->val);
 	XFREE(MTYPE_COMMUNITY_STR, (*com)->str);
+	XFREE(MTYPE_COMMUNITY_LIST_CACHE, (*com)->clist);
 
 	if ((*com)->json) {
 		json_object_free((*com)->json);
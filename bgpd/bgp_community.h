@@ -27,6 +27,9 @@ struct community {
 	/* String of community attribute.  This string is used by vty output
 	   and expanded community-list for regular expression match.  */
 	char *str;
+
+	/* Community-list match cache, only set while interned.  */
+	struct community_list_cache *clist;
 };
 
 /* Well-known communities value.  */
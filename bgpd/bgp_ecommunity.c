@@ -57,6 +57,7 @@ void ecommunity_free(struct ecommunity **ecom)
 
 	XFREE(MTYPE_ECOMMUNITY_VAL, (*ecom)->val);
 	XFREE(MTYPE_ECOMMUNITY_STR, (*ecom)->str);
+	XFREE(MTYPE_COMMUNITY_LIST_CACHE, (*ecom)->clist);
 	XFREE(MTYPE_ECOMMUNITY, *ecom);
 }
 
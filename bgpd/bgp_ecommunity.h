@@ -141,6 +141,9 @@ struct ecommunity {
 
 	/* Human readable format string.  */
 	char *str;
+
+	/* Community-list match cache, only set while interned.  */
+	struct community_list_cache *clist;
 };
 
 struct ecommunity_as {
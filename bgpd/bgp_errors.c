@@ -575,6 +575,12 @@ static struct log_ref ferr_bgp_err[] = {
 		.description = "BGP-LS NLRI or attribute packet parsing/encoding error",
 		.suggestion = "Check that BGP-LS peer is sending valid packets per RFC 9552. May indicate interoperability issue or malformed data.",
 	},
+	{
+		.code = EC_BGP_IO_THREADS,
+		.title = "I/O thread count specified is invalid",
+		.description = "BGP was started with an invalid number of I/O pthreads",
+		.suggestion = "Correct the io_threads value supplied when starting the BGP daemon",
+	},
 	{
 		.code = END_FERR,
 	}
@@ -1705,6 +1705,7 @@ static int update_evpn_type5_route_entry(struct bgp *bgp_evpn, struct bgp *bgp_v
 		}
 
 		/* Add (or update) attribute to hash. */
+		bgp_attr_ext_unshare(&static_attr);
 		attr_new = bgp_attr_intern(&static_attr);
 		bgp_attr_flush(&static_attr);
 
@@ -1754,6 +1755,7 @@ static int update_evpn_type5_route_entry(struct bgp *bgp_evpn, struct bgp *bgp_v
 			}
 			/* The attribute has changed. */
 			/* Add (or update) attribute to hash. */
+			bgp_attr_ext_unshare(&static_attr);
 			attr_new = bgp_attr_intern(&static_attr);
 			bgp_attr_flush(&static_attr);
 			bgp_path_info_set_flag(dest, tmp_pi,
@@ -1975,7 +1977,7 @@ static void update_evpn_route_entry_sync_info(struct bgp *bgp,
 					       &max_sync_seq, &active_on_peer,
 					       &peer_router, &proxy_from_peer,
 					       mac);
-			attr->mm_sync_seqnum = max_sync_seq;
+			bgp_attr_set_mm_sync_seqnum(attr, max_sync_seq);
 			if (active_on_peer)
 				SET_FLAG(attr->es_flags, ATTR_ES_PEER_ACTIVE);
 			else
@@ -2011,8 +2013,12 @@ static void update_evpn_route_entry_sync_info(struct bgp *bgp,
 						   : "");
 			}
 		}
-	} else {
-		attr->mm_sync_seqnum = 0;
+	} else if (!attr->refcnt) {
+		/* An interned attr (the VNI path's, when updating the global
+		 * table) was already reset when it was built, and must not be
+		 * modified now that it is in the attr hash.
+		 */
+		bgp_attr_set_mm_sync_seqnum(attr, 0);
 		UNSET_FLAG(attr->es_flags, ATTR_ES_PEER_ACTIVE);
 		UNSET_FLAG(attr->es_flags, ATTR_ES_PEER_PROXY);
 	}
@@ -2088,9 +2094,10 @@ static int update_evpn_route_entry(struct bgp *bgp, struct bgpevpn *vpn,
 
 	if (!local_pi) {
 		local_attr = *attr;
+		bgp_attr_ext_unshare(&local_attr);
 
 		/* Extract MAC mobility sequence number, if any. */
-		local_attr.mm_seqnum = bgp_attr_mac_mobility_seqnum(&local_attr);
+		bgp_attr_set_mm_seqnum(&local_attr, bgp_attr_mac_mobility_seqnum(&local_attr));
 
 		/* Add (or update) attribute to hash. */
 		attr_new = bgp_attr_intern(&local_attr);
@@ -2177,12 +2184,13 @@ static int update_evpn_route_entry(struct bgp *bgp, struct bgpevpn *vpn,
 			/* The attribute has changed. */
 			/* Add (or update) attribute to hash. */
 			local_attr = *attr;
+			bgp_attr_ext_unshare(&local_attr);
 			bgp_path_info_set_flag(dest, tmp_pi,
 					       BGP_PATH_ATTR_CHANGED);
 
 			/* Extract MAC mobility sequence number, if any. */
-			local_attr.mm_seqnum =
-				bgp_attr_mac_mobility_seqnum(&local_attr);
+			bgp_attr_set_mm_seqnum(&local_attr,
+					       bgp_attr_mac_mobility_seqnum(&local_attr));
 
 			attr_new = bgp_attr_intern(&local_attr);
 
@@ -2318,10 +2326,14 @@ static int update_evpn_route(struct bgp *bgp, struct bgpevpn *vpn,
 	if (p->prefix.route_type == BGP_EVPN_IMET_ROUTE) {
 		SET_FLAG(attr.flag, ATTR_FLAG_BIT(BGP_ATTR_PMSI_TUNNEL));
 		bgp_attr_set_pmsi_tnl_type(&attr, PMSI_TNLTYPE_INGR_REPL);
-		if (attr.mp_nexthop_len == BGP_ATTR_NHLEN_IPV4)
-			ipv4_to_ipv4_mapped_ipv6(&attr.tunn_id, attr.mp_nexthop_global_in);
-		else
-			IPV6_ADDR_COPY(&attr.tunn_id, &attr.mp_nexthop_global);
+		if (attr.mp_nexthop_len == BGP_ATTR_NHLEN_IPV4) {
+			struct in6_addr tunn_id;
+
+			ipv4_to_ipv4_mapped_ipv6(&tunn_id, attr.mp_nexthop_global_in);
+			bgp_attr_set_pmsi_tunn_id(&attr, &tunn_id);
+		} else {
+			bgp_attr_set_pmsi_tunn_id(&attr, &attr.mp_nexthop_global);
+		}
 	}
 
 	/* router mac is only needed for type-2 routes here. */
@@ -2453,6 +2465,7 @@ static int update_evpn_route(struct bgp *bgp, struct bgpevpn *vpn,
 
 	/* Unintern temporary. */
 	aspath_unintern(&attr.aspath);
+	bgp_attr_ext_flush(&attr);
 
 	return 0;
 }
@@ -2734,6 +2747,7 @@ void bgp_evpn_update_type2_route_entry(struct bgp *bgp, struct bgpevpn *vpn,
 
 	/* Unintern temporary. */
 	aspath_unintern(&attr.aspath);
+	bgp_attr_ext_flush(&attr);
 }
 
 static void update_type2_route(struct bgp *bgp, struct bgpevpn *vpn,
@@ -6857,6 +6871,7 @@ void bgp_evpn_export_type5_route(struct bgp *bgp, struct bgp_dest *dest, struct
 		return;
 	}
 	bgp_evpn_advertise_type5_route(bgp, pi, prefix, &tmp_attr, afi, safi, addpath_id);
+	bgp_attr_ext_flush(&tmp_attr);
 }
 
 /*
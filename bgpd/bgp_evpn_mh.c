@@ -196,7 +196,8 @@ static int bgp_evpn_es_route_select_install(struct bgp *bgp,
 
 			bgp_evpn_mh_get_vtep_ip(old_select->attr, &vtep_ip);
 			bgp_evpn_es_vtep_add(bgp, es, vtep_ip, true /*esr*/,
-					     old_select->attr->df_alg, old_select->attr->df_pref,
+					     bgp_attr_get_df_alg(old_select->attr),
+					     bgp_attr_get_df_pref(old_select->attr),
 					     &zret);
 		}
 		UNSET_FLAG(old_select->flags, BGP_PATH_MULTIPATH_CHG);
@@ -227,8 +228,9 @@ static int bgp_evpn_es_route_select_install(struct bgp *bgp,
 		struct ipaddr vtep_ip = {};
 
 		bgp_evpn_mh_get_vtep_ip(new_select->attr, &vtep_ip);
-		bgp_evpn_es_vtep_add(bgp, es, vtep_ip, true /*esr */, new_select->attr->df_alg,
-				     new_select->attr->df_pref, &zret);
+		bgp_evpn_es_vtep_add(bgp, es, vtep_ip, true /*esr */,
+				     bgp_attr_get_df_alg(new_select->attr),
+				     bgp_attr_get_df_pref(new_select->attr), &zret);
 	} else {
 		if (old_select && old_select->type == ZEBRA_ROUTE_BGP &&
 		    old_select->sub_type == BGP_ROUTE_IMPORTED) {
@@ -85,6 +85,8 @@ static void as_filter_free(struct as_filter *asfilter)
 {
 	if (asfilter->reg)
 		bgp_regex_free(asfilter->reg);
+	if (asfilter->asreg)
+		bgp_asregex_free(asfilter->asreg);
 	XFREE(MTYPE_AS_FILTER_STR, asfilter->reg_str);
 	XFREE(MTYPE_AS_FILTER, asfilter);
 }
@@ -97,6 +99,7 @@ static struct as_filter *as_filter_make(struct frregex *reg, const char *reg_str
 
 	asfilter = as_filter_new();
 	asfilter->reg = reg;
+	asfilter->asreg = bgp_asregcomp(reg_str);
 	asfilter->type = type;
 	asfilter->reg_str = XSTRDUP(MTYPE_AS_FILTER_STR, reg_str);
 
@@ -347,6 +350,14 @@ static void as_list_filter_delete(struct as_list *aslist,
 
 static bool as_filter_match(struct as_filter *asfilter, struct aspath *aspath)
 {
+	int ret;
+
+	if (asfilter->asreg) {
+		ret = bgp_asregexec(asfilter->asreg, aspath);
+		if (ret >= 0)
+			return ret;
+	}
+
 	return bgp_regexec(asfilter->reg, aspath) != REG_NOMATCH;
 }
 
@@ -24,6 +24,9 @@ struct as_filter {
 	struct frregex *reg;
 	char *reg_str;
 
+	/* Token matcher for reg, if reg_str is simple enough */
+	struct bgp_asregex *asreg;
+
 	/* Sequence number. */
 	int64_t seq;
 };
@@ -11,6 +11,7 @@
 #include <sys/uio.h>		// for writev
 
 #include "frr_pthread.h"
+#include "jhash.h"		// for jhash
 #include "linklist.h"		// for list_delete, list_delete_all_node, lis...
 #include "log.h"		// for zlog_debug, safe_strerror, zlog_err
 #include "memory.h"		// for MTYPE_TMP, XCALLOC, XFREE
@@ -35,16 +36,64 @@ static void bgp_process_writes(struct event *event);
 static void bgp_process_reads(struct event *event);
 static bool validate_header(struct peer_connection *connection);
 
+DEFINE_MTYPE_STATIC(BGPD, BGP_IO_SCRATCH, "BGP I/O scratch buffer");
+
+#ifndef thread_local
+#define thread_local __thread
+#endif
+
 /* generic i/o status codes */
 #define BGP_IO_TRANS_ERR (1 << 0) /* EAGAIN or similar occurred */
 #define BGP_IO_FATAL_ERR (1 << 1) /* some kind of fatal TCP error */
 #define BGP_IO_WORK_FULL_ERR (1 << 2) /* No room in work buffer */
 
+/* size of the per-pthread receive scratch buffer */
+#define BGP_IO_SCRATCH_SIZE                                                    \
+	(BGP_EXTENDED_MESSAGE_MAX_PACKET_SIZE * BGP_READ_PACKET_MAX)
+
+/*
+ * Map a connection onto the I/O pthread that services it.
+ *
+ * The mapping only depends on the connection itself and on the pool size,
+ * which is fixed at startup, so every on/off call for a given connection
+ * lands on the same pthread and its t_read/t_write events are always
+ * scheduled on and cancelled from the same event loop.
+ */
+static struct frr_pthread *bgp_io_pthread(const struct peer_connection *connection)
+{
+	uint32_t key;
+
+	if (bm->io_threads <= 1)
+		return bgp_pth_io[0];
+
+	key = jhash(&connection, sizeof(connection), 0);
+	return bgp_pth_io[key % bm->io_threads];
+}
+
 /* Thread external API ----------------------------------------------------- */
 
+void *bgp_io_start(void *arg)
+{
+	struct frr_pthread *fpt = arg;
+
+	fpt->data = XMALLOC(MTYPE_BGP_IO_SCRATCH, BGP_IO_SCRATCH_SIZE);
+
+	return frr_pthread_attr_default.start(arg);
+}
+
+int bgp_io_stop(struct frr_pthread *fpt, void **result)
+{
+	int ret;
+
+	ret = frr_pthread_attr_default.stop(fpt, result);
+	XFREE(MTYPE_BGP_IO_SCRATCH, fpt->data);
+
+	return ret;
+}
+
 void bgp_writes_on(struct peer_connection *connection)
 {
-	struct frr_pthread *fpt = bgp_pth_io;
+	struct frr_pthread *fpt = bgp_io_pthread(connection);
 
 	assert(fpt->running);
 
@@ -65,7 +114,7 @@ void bgp_writes_on(struct peer_connection *connection)
 void bgp_writes_off(struct peer_connection *connection)
 {
 	struct peer *peer = connection->peer;
-	struct frr_pthread *fpt = bgp_pth_io;
+	struct frr_pthread *fpt = bgp_io_pthread(connection);
 	struct stream *s;
 
 	assert(fpt->running);
@@ -86,7 +135,7 @@ void bgp_writes_off(struct peer_connection *connection)
 
 void bgp_reads_on(struct peer_connection *connection)
 {
-	struct frr_pthread *fpt = bgp_pth_io;
+	struct frr_pthread *fpt = bgp_io_pthread(connection);
 	assert(fpt->running);
 
 	assert(connection->status != Deleted);
@@ -106,7 +155,7 @@ void bgp_reads_on(struct peer_connection *connection)
 
 void bgp_reads_off(struct peer_connection *connection)
 {
-	struct frr_pthread *fpt = bgp_pth_io;
+	struct frr_pthread *fpt = bgp_io_pthread(connection);
 	assert(fpt->running);
 
 	event_cancel_async(fpt->master, &connection->t_read, NULL);
@@ -126,14 +175,12 @@ void bgp_reads_off(struct peer_connection *connection)
  */
 static void bgp_process_writes(struct event *event)
 {
-	static struct peer *peer;
 	struct peer_connection *connection = EVENT_ARG(event);
+	struct peer *peer = connection->peer;
 	uint16_t status;
 	bool reschedule = false;
 	bool fatal = false;
-	struct frr_pthread *fpt = bgp_pth_io;
-
-	peer = connection->peer;
+	struct frr_pthread *fpt = bgp_io_pthread(connection);
 
 	if (connection->fd < 0)
 		return;
@@ -237,12 +284,12 @@ static void bgp_process_reads(struct event *event)
 {
 	/* clang-format off */
 	struct peer_connection *connection = EVENT_ARG(event);
-	static struct peer *peer;       /* peer to read from */
+	struct peer *peer;              /* peer to read from */
 	uint16_t status;                /* bgp_read status code */
 	bool fatal = false;             /* whether fatal error occurred */
 	bool added_pkt = false;         /* whether we pushed onto ->connection.ibuf */
 	int code = 0;                   /* FSM code if error occurred */
-	static bool ibuf_full_logged;   /* Have we logged full already */
+	static thread_local bool ibuf_full_logged; /* Have we logged full already */
 	int ret = 1;
 	/* clang-format on */
 
@@ -251,7 +298,7 @@ static void bgp_process_reads(struct event *event)
 	if (bm->terminating || connection->fd < 0)
 		return;
 
-	struct frr_pthread *fpt = bgp_pth_io;
+	struct frr_pthread *fpt = bgp_io_pthread(connection);
 
 	frr_with_mutex (&connection->io_mtx) {
 		status = bgp_read(connection, &code);
@@ -504,7 +551,6 @@ done : {
 	return status;
 }
 
-uint8_t ibuf_scratch[BGP_EXTENDED_MESSAGE_MAX_PACKET_SIZE * BGP_READ_PACKET_MAX];
 /*
  * Reads a chunk of data from peer->connection.fd into
  * peer->connection.ibuf_work.
@@ -514,9 +560,9 @@ uint8_t ibuf_scratch[BGP_EXTENDED_MESSAGE_MAX_PACKET_SIZE * BGP_READ_PACKET_MAX]
  *
  * @return status flag (see top-of-file)
  *
- * PLEASE NOTE:  If we ever transform the bgp_read to be a pthread
- * per peer then we need to rethink the global ibuf_scratch
- * data structure above.
+ * The data is staged through the scratch buffer owned by the I/O pthread
+ * servicing this connection, so reads on different I/O pthreads never
+ * share it.
  */
 static uint16_t bgp_read(struct peer_connection *connection, int *code_p)
 {
@@ -524,6 +570,7 @@ static uint16_t bgp_read(struct peer_connection *connection, int *code_p)
 	ssize_t nbytes;  /* how many bytes we actually read */
 	size_t ibuf_work_space; /* space we can read into the work buf */
 	uint16_t status = 0;
+	uint8_t *ibuf_scratch = bgp_io_pthread(connection)->data;
 
 	ibuf_work_space = ringbuf_space(connection->ibuf_work);
 
@@ -532,7 +579,7 @@ static uint16_t bgp_read(struct peer_connection *connection, int *code_p)
 		return status;
 	}
 
-	readsize = MIN(ibuf_work_space, sizeof(ibuf_scratch));
+	readsize = MIN(ibuf_work_space, BGP_IO_SCRATCH_SIZE);
 
 #ifdef __clang_analyzer__
 	/* clang-SA doesn't want you to call read() while holding a mutex */
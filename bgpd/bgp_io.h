@@ -18,20 +18,24 @@
 struct peer_connection;
 
 /**
- * Start function for write thread.
+ * Start function for an I/O pthread.
  *
- * @param arg - unused
+ * Allocates the pthread's private receive scratch buffer and then runs the
+ * default frr_pthread event loop.
+ *
+ * @param arg - the frr_pthread being started
  */
 extern void *bgp_io_start(void *arg);
 
 /**
- * Start function for write thread.
+ * Stop function for an I/O pthread.
  *
- * Uninitializes all resources and stops the thread.
+ * Stops the event loop, joins the pthread and releases its scratch buffer.
  *
+ * @param fpt - the frr_pthread to stop
  * @param result - where to store data result, unused
  */
-extern int bgp_io_stop(void **result, struct frr_pthread *fpt);
+extern int bgp_io_stop(struct frr_pthread *fpt, void **result);
 
 /**
  * Turns on packet writing for a peer.
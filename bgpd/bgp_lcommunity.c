@@ -36,6 +36,7 @@ void lcommunity_free(struct lcommunity **lcom)
 
 	XFREE(MTYPE_LCOMMUNITY_VAL, (*lcom)->val);
 	XFREE(MTYPE_LCOMMUNITY_STR, (*lcom)->str);
+	XFREE(MTYPE_COMMUNITY_LIST_CACHE, (*lcom)->clist);
 	if ((*lcom)->json)
 		json_object_free((*lcom)->json);
 	XFREE(MTYPE_LCOMMUNITY, *lcom);
@@ -30,6 +30,9 @@ struct lcommunity {
 
 	/* Human readable format string.  */
 	char *str;
+
+	/* Community-list match cache, only set while interned.  */
+	struct community_list_cache *clist;
 };
 
 /* Large community value is 12 octets.  */
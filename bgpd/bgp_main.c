@@ -72,6 +72,7 @@ static const struct option longopts[] = { { "bgp_port", required_argument, NULL,
 					  { "no_zebra", no_argument, NULL, 'Z' },
 					  { "socket_size", required_argument, NULL, 's' },
 					  { "v6-with-v4-nexthops", no_argument, NULL, 'x' },
+					  { "io_threads", required_argument, NULL, 'T' },
 					  { 0 } };
 
 /* signal definitions */
@@ -416,11 +417,12 @@ int main(int argc, char **argv)
 	char *address;
 	struct listnode *node;
 	bool v6_with_v4_nexthops = false;
+	uint32_t io_threads = BGP_IO_THREADS_DEFAULT;
 
 	addresses->cmp = (int (*)(void *, void *))strcmp;
 
 	frr_preinit(&bgpd_di, argc, argv);
-	frr_opt_add("p:l:SnZe:I:s:x" DEPRECATED_OPTIONS, longopts,
+	frr_opt_add("p:l:SnZe:I:s:xT:" DEPRECATED_OPTIONS, longopts,
 		    "  -p, --bgp_port           Set BGP listen port number (0 means do not listen).\n"
 		    "  -l, --listenon           Listen on specified address (implies -n)\n"
 		    "  -n, --no_kernel          Do not install route to kernel.\n"
@@ -429,7 +431,8 @@ int main(int argc, char **argv)
 		    "  -e, --ecmp               Specify ECMP to use.\n"
 		    "  -I, --int_num            Set instance number (label-manager)\n"
 		    "  -s, --socket_size        Set BGP peer socket send buffer size\n"
-		    "  -x, --v6-with-v4-nexthop Allow BGP to form v6 neighbors using v4 nexthops\n");
+		    "  -x, --v6-with-v4-nexthop Allow BGP to form v6 neighbors using v4 nexthops\n"
+		    "  -T, --io_threads         Number of pthreads used for peer socket I/O\n");
 
 	/* Command line argument treatment. */
 	while (1) {
@@ -495,6 +498,19 @@ int main(int argc, char **argv)
 		case 'x':
 			v6_with_v4_nexthops = true;
 			break;
+		case 'T': {
+			unsigned long int parsed_io_threads =
+				strtoul(optarg, NULL, 10);
+			if (parsed_io_threads == 0 ||
+			    parsed_io_threads > BGP_IO_THREADS_MAX) {
+				flog_err(EC_BGP_IO_THREADS,
+					 "Number of I/O threads must be between 1 and %u",
+					 BGP_IO_THREADS_MAX);
+				return 1;
+			}
+			io_threads = parsed_io_threads;
+			break;
+		}
 		default:
 			frr_help_exit(1);
 		}
@@ -508,6 +524,7 @@ int main(int argc, char **argv)
 	bm->startup_time = monotime(NULL);
 	bm->port = bgp_port;
 	bm->v6_with_v4_nexthops = v6_with_v4_nexthops;
+	bm->io_threads = io_threads;
 	if (bgp_port == 0)
 		bgp_option_set(BGP_OPT_NO_LISTEN);
 	if (no_fib_flag || no_zebra_flag)
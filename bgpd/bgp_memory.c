@@ -34,6 +34,7 @@ DEFINE_MTYPE(BGPD, AS_PATH, "BGP aspath");
 DEFINE_MTYPE(BGPD, AS_SEG, "BGP aspath seg");
 DEFINE_MTYPE(BGPD, AS_SEG_DATA, "BGP aspath segment data");
 DEFINE_MTYPE(BGPD, AS_STR, "BGP aspath str");
+DEFINE_MTYPE(BGPD, AS_FLAT, "BGP aspath flat ASNs");
 
 DEFINE_MTYPE(BGPD, BGP_TABLE, "BGP table");
 DEFINE_MTYPE(BGPD, BGP_NODE, "BGP node");
@@ -71,6 +72,7 @@ DEFINE_MTYPE(BGPD, COMMUNITY_LIST_NAME, "community-list name");
 DEFINE_MTYPE(BGPD, COMMUNITY_LIST_ENTRY, "community-list entry");
 DEFINE_MTYPE(BGPD, COMMUNITY_LIST_CONFIG, "community-list config");
 DEFINE_MTYPE(BGPD, COMMUNITY_LIST_HANDLER, "community-list handler");
+DEFINE_MTYPE(BGPD, COMMUNITY_LIST_CACHE, "community-list match cache");
 
 DEFINE_MTYPE(BGPD, CLUSTER, "Cluster list");
 DEFINE_MTYPE(BGPD, CLUSTER_VAL, "Cluster list val");
@@ -137,6 +139,8 @@ DEFINE_MTYPE(BGPD, BGP_NOTIFICATION, "BGP Notification Message");
 DEFINE_MTYPE(BGPD, BGP_SOFT_VERSION, "Software Version");
 
 DEFINE_MTYPE(BGPD, BGP_EVPN_OVERLAY, "BGP EVPN Overlay");
+DEFINE_MTYPE(BGPD, BGP_ATTR_EXT, "BGP attribute extension");
+DEFINE_MTYPE(BGPD, BGP_RMAP_MEMO, "BGP route-map memo");
 
 DEFINE_MTYPE(BGPD, BGP_NHC, "BGP NHC");
 DEFINE_MTYPE(BGPD, BGP_NHC_TLV, "BGP NHC TLV");
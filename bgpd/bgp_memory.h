@@ -30,6 +30,7 @@ DECLARE_MTYPE(AS_PATH);
 DECLARE_MTYPE(AS_SEG);
 DECLARE_MTYPE(AS_SEG_DATA);
 DECLARE_MTYPE(AS_STR);
+DECLARE_MTYPE(AS_FLAT);
 
 DECLARE_MTYPE(BGP_TABLE);
 DECLARE_MTYPE(BGP_NODE);
@@ -67,6 +68,7 @@ DECLARE_MTYPE(COMMUNITY_LIST_NAME);
 DECLARE_MTYPE(COMMUNITY_LIST_ENTRY);
 DECLARE_MTYPE(COMMUNITY_LIST_CONFIG);
 DECLARE_MTYPE(COMMUNITY_LIST_HANDLER);
+DECLARE_MTYPE(COMMUNITY_LIST_CACHE);
 
 DECLARE_MTYPE(CLUSTER);
 DECLARE_MTYPE(CLUSTER_VAL);
@@ -135,6 +137,8 @@ DECLARE_MTYPE(BGP_NOTIFICATION);
 DECLARE_MTYPE(BGP_SOFT_VERSION);
 
 DECLARE_MTYPE(BGP_EVPN_OVERLAY);
+DECLARE_MTYPE(BGP_ATTR_EXT);
+DECLARE_MTYPE(BGP_RMAP_MEMO);
 
 DECLARE_MTYPE(BGP_NHC);
 DECLARE_MTYPE(BGP_NHC_TLV);
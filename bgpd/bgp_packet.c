@@ -2312,54 +2312,77 @@ static void bgp_update_receive_eor(struct bgp *bgp, struct peer *peer, afi_t afi
 		bgp_clear_stale_route(peer, afi, safi);
 }
 
+/* NLRI sections an UPDATE message can carry */
+enum bgp_update_nlri_type {
+	NLRI_UPDATE,
+	NLRI_WITHDRAW,
+	NLRI_MP_UPDATE,
+	NLRI_MP_WITHDRAW,
+	NLRI_TYPE_MAX
+};
+
+/*
+ * Decoded form of a received UPDATE message.
+ *
+ * bgp_update_decode() fills this in from the packet alone: the parsed path
+ * attributes plus the location and AFI/SAFI of every NLRI section.
+ * bgp_update_apply() consumes it and is the only stage that touches the RIB.
+ */
+struct bgp_update_msg {
+	struct attr attr;
+	enum bgp_attr_parse_ret attr_parse_ret;
+
+	bgp_size_t withdraw_len;
+	bgp_size_t attribute_len;
+	bgp_size_t update_len;
+
+	struct bgp_nlri nlris[NLRI_TYPE_MAX];
+};
+
+/*
+ * Certain attribute parsing errors should not be considered bad enough to
+ * reset the session for, most particularly any partial/optional attributes
+ * that have 'tunneled' over speakers that don't understand them. Instead we
+ * withdraw only the prefix concerned: this morphs the update case into a
+ * withdraw when lower levels have signalled an error condition where this
+ * is best.
+ */
+static inline struct attr *bgp_update_msg_attr(struct bgp_update_msg *msg)
+{
+	if (msg->attr_parse_ret == BGP_ATTR_PARSE_WITHDRAW ||
+	    msg->attr_parse_ret == BGP_ATTR_PARSE_WITHDRAW_IGNORE)
+		return NULL;
+
+	return &msg->attr;
+}
+
 /**
- * Process BGP UPDATE message for peer.
+ * Decode a BGP UPDATE message.
  *
- * Parses UPDATE and creates attribute object.
+ * Validates the message framing, parses the path attributes and locates the
+ * NLRI sections. No route is added or withdrawn here.
  *
+ * @param connection connection the message was received on
  * @param peer
  * @param size size of the packet
- * @return as in summary
+ * @param msg decoded message, only valid if 0 is returned
+ * @return 0 on success, BGP_Stop if the session has to be torn down
  */
-static int bgp_update_receive(struct peer_connection *connection,
-			      struct peer *peer, bgp_size_t size)
+static int bgp_update_decode(struct peer_connection *connection,
+			     struct peer *peer, bgp_size_t size,
+			     struct bgp_update_msg *msg)
 {
-	int ret, nlri_ret;
+	int ret;
 	uint8_t *end;
 	struct stream *s;
-	struct attr attr;
-	bgp_size_t attribute_len;
-	bgp_size_t update_len;
-	bgp_size_t withdraw_len;
-	struct bgp *bgp = peer->bgp;
-
-	enum NLRI_TYPES {
-		NLRI_UPDATE,
-		NLRI_WITHDRAW,
-		NLRI_MP_UPDATE,
-		NLRI_MP_WITHDRAW,
-		NLRI_TYPE_MAX
-	};
-	struct bgp_nlri nlris[NLRI_TYPE_MAX];
-
-	/* Status must be Established. */
-	if (!peer_established(connection)) {
-		flog_err(EC_BGP_INVALID_STATUS,
-			 "%s [FSM] Update packet received under status %s",
-			 peer->host,
-			 lookup_msg(bgp_status_msg, peer->connection->status,
-				    NULL));
-		bgp_notify_send(connection, BGP_NOTIFY_FSM_ERR,
-				bgp_fsm_error_subcode(peer->connection->status));
-		return BGP_Stop;
-	}
+	struct attr *attr = &msg->attr;
 
 	/* Set initial values. */
-	memset(&attr, 0, sizeof(attr));
-	attr.label_index = BGP_INVALID_LABEL_INDEX;
-	attr.label = MPLS_INVALID_LABEL;
-	memset(&nlris, 0, sizeof(nlris));
-	memset(peer->rcvd_attr_str, 0, BUFSIZ);
+	memset(msg, 0, sizeof(*msg));
+	attr->label_index = BGP_INVALID_LABEL_INDEX;
+	attr->label = MPLS_INVALID_LABEL;
+	msg->attr_parse_ret = BGP_ATTR_PARSE_PROCEED;
+	peer->rcvd_attr_str[0] = '\0';
 	peer->rcvd_attr_printed = false;
 
 	s = connection->curr;
@@ -2379,25 +2402,25 @@ static int bgp_update_receive(struct peer_connection *connection,
 	}
 
 	/* Unfeasible Route Length. */
-	withdraw_len = stream_getw(s);
+	msg->withdraw_len = stream_getw(s);
 
 	/* Unfeasible Route Length check. */
-	if (stream_pnt(s) + withdraw_len > end) {
+	if (stream_pnt(s) + msg->withdraw_len > end) {
 		flog_err(EC_BGP_UPDATE_RCV,
 			 "%s [Error] Update packet error (packet unfeasible length overflow %d)",
-			 peer->host, withdraw_len);
+			 peer->host, msg->withdraw_len);
 		bgp_notify_send(connection, BGP_NOTIFY_UPDATE_ERR,
 				BGP_NOTIFY_UPDATE_MAL_ATTR);
 		return BGP_Stop;
 	}
 
 	/* Unfeasible Route packet format check. */
-	if (withdraw_len > 0) {
-		nlris[NLRI_WITHDRAW].afi = AFI_IP;
-		nlris[NLRI_WITHDRAW].safi = SAFI_UNICAST;
-		nlris[NLRI_WITHDRAW].nlri = stream_pnt(s);
-		nlris[NLRI_WITHDRAW].length = withdraw_len;
-		stream_forward_getp(s, withdraw_len);
+	if (msg->withdraw_len > 0) {
+		msg->nlris[NLRI_WITHDRAW].afi = AFI_IP;
+		msg->nlris[NLRI_WITHDRAW].safi = SAFI_UNICAST;
+		msg->nlris[NLRI_WITHDRAW].nlri = stream_pnt(s);
+		msg->nlris[NLRI_WITHDRAW].length = msg->withdraw_len;
+		stream_forward_getp(s, msg->withdraw_len);
 	}
 
 	/* Attribute total length check. */
@@ -2412,58 +2435,42 @@ static int bgp_update_receive(struct peer_connection *connection,
 	}
 
 	/* Fetch attribute total length. */
-	attribute_len = stream_getw(s);
+	msg->attribute_len = stream_getw(s);
 
 	/* Attribute length check. */
-	if (stream_pnt(s) + attribute_len > end) {
+	if (stream_pnt(s) + msg->attribute_len > end) {
 		flog_warn(
 			EC_BGP_UPDATE_PACKET_LONG,
 			"%s [Error] Packet Error (update packet attribute length overflow %d)",
-			peer->host, attribute_len);
+			peer->host, msg->attribute_len);
 		bgp_notify_send(connection, BGP_NOTIFY_UPDATE_ERR,
 				BGP_NOTIFY_UPDATE_MAL_ATTR);
 		return BGP_Stop;
 	}
 
-	/* Certain attribute parsing errors should not be considered bad enough
-	 * to reset the session for, most particularly any partial/optional
-	 * attributes that have 'tunneled' over speakers that don't understand
-	 * them. Instead we withdraw only the prefix concerned.
-	 *
-	 * Complicates the flow a little though..
-	 */
-	enum bgp_attr_parse_ret attr_parse_ret = BGP_ATTR_PARSE_PROCEED;
-/* This define morphs the update case into a withdraw when lower levels
- * have signalled an error condition where this is best.
- */
-#define NLRI_ATTR_ARG                                                                             \
-	((attr_parse_ret != BGP_ATTR_PARSE_WITHDRAW &&                                            \
-	  attr_parse_ret != BGP_ATTR_PARSE_WITHDRAW_IGNORE)                                       \
-		 ? &attr                                                                          \
-		 : NULL)
-
 	/* Parse attribute when it exists. */
-	if (attribute_len) {
-		attr_parse_ret = bgp_attr_parse(peer, &attr, attribute_len,
-						&nlris[NLRI_MP_UPDATE],
-						&nlris[NLRI_MP_WITHDRAW]);
-		if (attr_parse_ret == BGP_ATTR_PARSE_ERROR) {
-			bgp_attr_unintern_sub(&attr);
+	if (msg->attribute_len) {
+		msg->attr_parse_ret =
+			bgp_attr_parse(peer, attr, msg->attribute_len,
+				       &msg->nlris[NLRI_MP_UPDATE],
+				       &msg->nlris[NLRI_MP_WITHDRAW]);
+		if (msg->attr_parse_ret == BGP_ATTR_PARSE_ERROR) {
+			bgp_attr_unintern_sub(attr);
 			return BGP_Stop;
 		}
 	}
 
 	/* Logging the attribute. */
-	if (attr_parse_ret == BGP_ATTR_PARSE_WITHDRAW ||
-	    attr_parse_ret == BGP_ATTR_PARSE_WITHDRAW_IGNORE || BGP_DEBUG(update, UPDATE_IN) ||
-	    BGP_DEBUG(update, UPDATE_PREFIX)) {
-		ret = bgp_dump_attr(&attr, peer->rcvd_attr_str,
+	if (msg->attr_parse_ret == BGP_ATTR_PARSE_WITHDRAW ||
+	    msg->attr_parse_ret == BGP_ATTR_PARSE_WITHDRAW_IGNORE ||
+	    BGP_DEBUG(update, UPDATE_IN) || BGP_DEBUG(update, UPDATE_PREFIX)) {
+		ret = bgp_dump_attr(attr, peer->rcvd_attr_str,
 				    sizeof(peer->rcvd_attr_str));
 
-		if (attr_parse_ret == BGP_ATTR_PARSE_WITHDRAW ||
-		    attr_parse_ret == BGP_ATTR_PARSE_WITHDRAW_IGNORE) {
+		if (msg->attr_parse_ret == BGP_ATTR_PARSE_WITHDRAW ||
+		    msg->attr_parse_ret == BGP_ATTR_PARSE_WITHDRAW_IGNORE) {
 			peer->stat_pfx_withdraw++;
-			if (attr_parse_ret == BGP_ATTR_PARSE_WITHDRAW)
+			if (msg->attr_parse_ret == BGP_ATTR_PARSE_WITHDRAW)
 				flog_err(EC_BGP_UPDATE_RCV,
 					 "%pBP rcvd UPDATE with errors in attr(s)!! Withdrawing route.",
 					 peer);
@@ -2478,28 +2485,28 @@ static int bgp_update_receive(struct peer_connection *connection,
 	}
 
 	/* Network Layer Reachability Information. */
-	update_len = end - stream_pnt(s);
+	msg->update_len = end - stream_pnt(s);
 
 	/* If we received MP_UNREACH_NLRI attribute, but also NLRIs, then
 	 * NLRIs should be handled as a new data. Though, if we received
 	 * NLRIs without mandatory attributes, they should be ignored.
 	 */
-	if (update_len && attribute_len &&
-	    attr_parse_ret != BGP_ATTR_PARSE_MISSING_MANDATORY) {
+	if (msg->update_len && msg->attribute_len &&
+	    msg->attr_parse_ret != BGP_ATTR_PARSE_MISSING_MANDATORY) {
 		/* Set NLRI portion to structure. */
-		nlris[NLRI_UPDATE].afi = AFI_IP;
-		nlris[NLRI_UPDATE].safi = SAFI_UNICAST;
-		nlris[NLRI_UPDATE].nlri = stream_pnt(s);
-		nlris[NLRI_UPDATE].length = update_len;
-		stream_forward_getp(s, update_len);
+		msg->nlris[NLRI_UPDATE].afi = AFI_IP;
+		msg->nlris[NLRI_UPDATE].safi = SAFI_UNICAST;
+		msg->nlris[NLRI_UPDATE].nlri = stream_pnt(s);
+		msg->nlris[NLRI_UPDATE].length = msg->update_len;
+		stream_forward_getp(s, msg->update_len);
 
-		if (CHECK_FLAG(attr.flag, ATTR_FLAG_BIT(BGP_ATTR_MP_REACH_NLRI))) {
+		if (CHECK_FLAG(attr->flag, ATTR_FLAG_BIT(BGP_ATTR_MP_REACH_NLRI))) {
 			/*
 			 * We skipped nexthop attribute validation earlier so
 			 * validate the nexthop now.
 			 */
-			if (bgp_attr_nexthop_valid(peer, &attr) < 0) {
-				bgp_attr_unintern_sub(&attr);
+			if (bgp_attr_nexthop_valid(peer, attr) < 0) {
+				bgp_attr_unintern_sub(attr);
 				return BGP_Stop;
 			}
 		}
@@ -2507,7 +2514,30 @@ static int bgp_update_receive(struct peer_connection *connection,
 
 	if (BGP_DEBUG(update, UPDATE_IN) && BGP_DEBUG(update, UPDATE_DETAIL))
 		zlog_debug("%pBP rcvd UPDATE wlen %d attrlen %d alen %d", peer,
-			   withdraw_len, attribute_len, update_len);
+			   msg->withdraw_len, msg->attribute_len,
+			   msg->update_len);
+
+	return 0;
+}
+
+/**
+ * Apply a decoded BGP UPDATE message.
+ *
+ * Adds or withdraws every prefix carried by the message and handles
+ * End-of-RIB markers. Releases the temporary attribute references taken
+ * by bgp_update_decode().
+ *
+ * @param connection connection the message was received on
+ * @param peer
+ * @param msg message filled in by bgp_update_decode()
+ * @return as in summary
+ */
+static int bgp_update_apply(struct peer_connection *connection,
+			    struct peer *peer, struct bgp_update_msg *msg)
+{
+	int nlri_ret;
+	struct attr *attr = &msg->attr;
+	struct bgp_nlri *nlris = msg->nlris;
 
 	/* Parse any given NLRIs */
 	for (int i = NLRI_UPDATE; i < NLRI_TYPE_MAX; i++) {
@@ -2530,12 +2560,12 @@ static int bgp_update_receive(struct peer_connection *connection,
 		switch (i) {
 		case NLRI_UPDATE:
 		case NLRI_MP_UPDATE:
-			nlri_ret = bgp_nlri_parse(peer, NLRI_ATTR_ARG,
+			nlri_ret = bgp_nlri_parse(peer, bgp_update_msg_attr(msg),
 						  &nlris[i], 0);
 			break;
 		case NLRI_WITHDRAW:
 		case NLRI_MP_WITHDRAW:
-			nlri_ret = bgp_nlri_parse(peer, NLRI_ATTR_ARG,
+			nlri_ret = bgp_nlri_parse(peer, bgp_update_msg_attr(msg),
 						  &nlris[i], 1);
 			break;
 		default:
@@ -2552,7 +2582,7 @@ static int bgp_update_receive(struct peer_connection *connection,
 						i <= NLRI_WITHDRAW
 							? BGP_NOTIFY_UPDATE_INVAL_NETWORK
 							: BGP_NOTIFY_UPDATE_OPT_ATTR_ERR);
-			bgp_attr_unintern_sub(&attr);
+			bgp_attr_unintern_sub(attr);
 			return BGP_Stop;
 		}
 	}
@@ -2562,29 +2592,30 @@ static int bgp_update_receive(struct peer_connection *connection,
 	 * Non-MP IPv4/Unicast EoR is a completely empty UPDATE
 	 * and MP EoR should have only an empty MP_UNREACH
 	 */
-	if (!update_len && !withdraw_len && nlris[NLRI_MP_UPDATE].length == 0) {
+	if (!msg->update_len && !msg->withdraw_len &&
+	    nlris[NLRI_MP_UPDATE].length == 0) {
 		afi_t afi = 0;
 		safi_t safi;
 		/* Non-MP IPv4/Unicast is a completely empty UPDATE - already
 		 * checked
 		 * update and withdraw NLRI lengths are 0.
 		 */
-		if (!attribute_len) {
+		if (!msg->attribute_len) {
 			afi = AFI_IP;
 			safi = SAFI_UNICAST;
-		} else if (attr.flag & ATTR_FLAG_BIT(BGP_ATTR_MP_UNREACH_NLRI)
+		} else if (attr->flag & ATTR_FLAG_BIT(BGP_ATTR_MP_UNREACH_NLRI)
 			   && nlris[NLRI_MP_WITHDRAW].length == 0) {
 			afi = nlris[NLRI_MP_WITHDRAW].afi;
 			safi = nlris[NLRI_MP_WITHDRAW].safi;
 		}
 
 		if (afi && peer->afc[afi][safi])
-			bgp_update_receive_eor(bgp, peer, afi, safi);
+			bgp_update_receive_eor(peer->bgp, peer, afi, safi);
 	}
 
 	/* Everything is done.  We unintern temporary structures which
 	   interned in bgp_attr_parse(). */
-	bgp_attr_unintern_sub(&attr);
+	bgp_attr_unintern_sub(attr);
 
 	peer->update_time = monotime(NULL);
 
@@ -2594,6 +2625,40 @@ static int bgp_update_receive(struct peer_connection *connection,
 	return Receive_UPDATE_message;
 }
 
+/**
+ * Process BGP UPDATE message for peer.
+ *
+ * Runs the two UPDATE stages back to back: bgp_update_decode() parses the
+ * message and creates the attribute object, bgp_update_apply() installs or
+ * withdraws the carried prefixes.
+ *
+ * @param peer
+ * @param size size of the packet
+ * @return as in summary
+ */
+static int bgp_update_receive(struct peer_connection *connection,
+			      struct peer *peer, bgp_size_t size)
+{
+	struct bgp_update_msg msg;
+
+	/* Status must be Established. */
+	if (!peer_established(connection)) {
+		flog_err(EC_BGP_INVALID_STATUS,
+			 "%s [FSM] Update packet received under status %s",
+			 peer->host,
+			 lookup_msg(bgp_status_msg, peer->connection->status,
+				    NULL));
+		bgp_notify_send(connection, BGP_NOTIFY_FSM_ERR,
+				bgp_fsm_error_subcode(peer->connection->status));
+		return BGP_Stop;
+	}
+
+	if (bgp_update_decode(connection, peer, size, &msg) == BGP_Stop)
+		return BGP_Stop;
+
+	return bgp_update_apply(connection, peer, &msg);
+}
+
 /**
  * Process BGP NOTIFY message for peer.
  *
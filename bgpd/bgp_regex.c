@@ -73,3 +73,182 @@ void bgp_regex_free(struct frregex *regex)
 	regfree(&regex->real);
 	XFREE(MTYPE_BGP_REGEXP, regex);
 }
+
+/* Most as-path access-list entries are a run of whole ASNs, optionally
+   anchored: "_N_", "^N_", "_N$", "^N_M_", "_(N|M)_", "^$" and so on.
+
+   On a path made of a single AS_SEQUENCE in plain notation the string
+   is the ASNs separated by single spaces, so `_' between two ASNs can
+   only match that space and such a regex matches exactly when the run
+   of ASNs occurs in the segment.  bgp_asregcomp() recognises these
+   shapes and bgp_asregexec() evaluates them on the ASN array without
+   looking at the string.  Other regexes, and paths with sets or
+   confederation segments, are left to bgp_regexec(). */
+
+#define BGP_ASREGEX_MAX 32
+
+struct bgp_asregex {
+	bool anchor_start;
+	bool anchor_end;
+	uint8_t ntokens;
+	uint8_t nasns;
+
+	/* Alternatives of token i are asns[first[i]] .. asns[first[i+1]-1] */
+	uint8_t first[BGP_ASREGEX_MAX + 1];
+	as_t asns[BGP_ASREGEX_MAX];
+};
+
+/* Parse an ASN the way it would be printed.  Leading zeros never match
+   a printed ASN like the number itself does, so they are rejected. */
+static const char *bgp_asregex_asn(const char *p, as_t *asn)
+{
+	const char *start = p;
+	uint64_t val = 0;
+
+	while (*p >= '0' && *p <= '9') {
+		val = val * 10 + (*p - '0');
+		if (val > UINT32_MAX)
+			return NULL;
+		p++;
+	}
+
+	if (p == start || (*start == '0' && p - start > 1))
+		return NULL;
+
+	*asn = val;
+	return p;
+}
+
+/* Parse one token, a single ASN or a group of alternatives. */
+static const char *bgp_asregex_token(const char *p, struct bgp_asregex *re)
+{
+	bool group = (*p == '(');
+
+	if (re->ntokens == BGP_ASREGEX_MAX)
+		return NULL;
+
+	re->first[re->ntokens] = re->nasns;
+	if (group)
+		p++;
+
+	for (;;) {
+		if (re->nasns == BGP_ASREGEX_MAX)
+			return NULL;
+
+		p = bgp_asregex_asn(p, &re->asns[re->nasns++]);
+		if (!p)
+			return NULL;
+
+		if (!group)
+			break;
+		if (*p == ')') {
+			p++;
+			break;
+		}
+		if (*p++ != '|')
+			return NULL;
+	}
+
+	re->ntokens++;
+	re->first[re->ntokens] = re->nasns;
+	return p;
+}
+
+struct bgp_asregex *bgp_asregcomp(const char *regstr)
+{
+	struct bgp_asregex re = {};
+	struct bgp_asregex *new;
+	const char *p = regstr;
+
+	if (strcmp(regstr, "^$") == 0) {
+		re.anchor_start = true;
+		re.anchor_end = true;
+		goto done;
+	}
+
+	if (*p == '^')
+		re.anchor_start = true;
+	else if (*p != '_')
+		return NULL;
+	p++;
+
+	for (;;) {
+		p = bgp_asregex_token(p, &re);
+		if (!p)
+			return NULL;
+
+		if (*p == '$') {
+			re.anchor_end = true;
+			p++;
+			break;
+		}
+		if (*p++ != '_')
+			return NULL;
+		if (*p == '\0')
+			break;
+	}
+
+	if (*p != '\0')
+		return NULL;
+
+done:
+	new = XMALLOC(MTYPE_BGP_REGEXP, sizeof(*new));
+	*new = re;
+	return new;
+}
+
+static bool bgp_asregex_run(const struct bgp_asregex *re, const as_t *asns)
+{
+	unsigned int t, a;
+
+	for (t = 0; t < re->ntokens; t++) {
+		for (a = re->first[t]; a < re->first[t + 1]; a++)
+			if (asns[t] == re->asns[a])
+				break;
+		if (a == re->first[t + 1])
+			return false;
+	}
+
+	return true;
+}
+
+/* Returns 1 on match, 0 if there is none and -1 if the path has to be
+   matched as a string by bgp_regexec(). */
+int bgp_asregexec(const struct bgp_asregex *re, struct aspath *aspath)
+{
+	const struct assegment *seg = aspath->segments;
+	const as_t *asns = NULL;
+	uint32_t len = 0;
+	uint32_t i, last;
+
+	if (aspath->asnotation != ASNOTATION_PLAIN)
+		return -1;
+
+	if (seg) {
+		if (seg->type != AS_SEQUENCE || seg->next)
+			return -1;
+		asns = seg->as;
+		len = seg->length;
+	}
+
+	if (len < re->ntokens)
+		return 0;
+	if (re->anchor_start && re->anchor_end && len != re->ntokens)
+		return 0;
+
+	last = len - re->ntokens;
+	i = re->anchor_end ? last : 0;
+	if (re->anchor_start)
+		last = 0;
+
+	for (; i <= last; i++)
+		if (bgp_asregex_run(re, asns + i))
+			return 1;
+
+	return 0;
+}
+
+void bgp_asregex_free(struct bgp_asregex *re)
+{
+	XFREE(MTYPE_BGP_REGEXP, re);
+}
@@ -9,9 +9,14 @@
 #include <zebra.h>
 
 struct frregex;
+struct bgp_asregex;
 
 extern void bgp_regex_free(struct frregex *regex);
 extern struct frregex *bgp_regcomp(const char *str);
 extern int bgp_regexec(struct frregex *regex, struct aspath *aspath);
 
+extern struct bgp_asregex *bgp_asregcomp(const char *str);
+extern int bgp_asregexec(const struct bgp_asregex *re, struct aspath *aspath);
+extern void bgp_asregex_free(struct bgp_asregex *re);
+
 #endif /* _FRR_BGP_REGEX_H */
@@ -110,6 +110,10 @@ DEFINE_MTYPE_STATIC(BGPD, BGP_METAQ, "BGP MetaQ");
 /* Memory for batched clearing of peers from the RIB */
 DEFINE_MTYPE(BGPD, CLEARING_BATCH, "Clearing batch");
 
+DEFINE_MPOOL(BGP_ROUTE, BGP_ROUTE, sizeof(struct bgp_path_info));
+DEFINE_MPOOL_STATIC(BGP_ROUTE_EXTRA, BGP_ROUTE_EXTRA,
+		    sizeof(struct bgp_path_info_extra));
+
 DEFINE_HOOK(bgp_snmp_update_stats,
 	    (struct bgp_dest *rn, struct bgp_path_info *pi, bool added),
 	    (rn, pi, added));
@@ -314,8 +318,7 @@ struct bgp_dest *bgp_safi_node_lookup(struct bgp_table *table, safi_t safi,
 static struct bgp_path_info_extra *bgp_path_info_extra_new(void)
 {
 	struct bgp_path_info_extra *new;
-	new = XCALLOC(MTYPE_BGP_ROUTE_EXTRA,
-		      sizeof(struct bgp_path_info_extra));
+	new = XPOOL_CALLOC(BGP_ROUTE_EXTRA);
 	new->flowspec = NULL;
 	return new;
 }
@@ -389,7 +392,7 @@ void bgp_path_info_extra_free(struct bgp_path_info_extra **extra)
 	if (e->labels)
 		bgp_labels_unintern(&e->labels);
 
-	XFREE(MTYPE_BGP_ROUTE_EXTRA, *extra);
+	XPOOL_FREE(BGP_ROUTE_EXTRA, *extra);
 }
 
 /* Get bgp_path_info extra information for the given bgp_path_info, lazy
@@ -455,7 +458,7 @@ void bgp_path_info_free_with_caller(const char *name,
 
 	peer_unlock(path->peer); /* bgp_path_info peer reference */
 
-	XFREE(MTYPE_BGP_ROUTE, path);
+	XPOOL_FREE(BGP_ROUTE, path);
 }
 
 struct bgp_path_info *bgp_path_info_lock(struct bgp_path_info *path)
@@ -2089,6 +2092,8 @@ static int bgp_input_modifier(struct peer *peer, const struct prefix *p,
 	struct bgp_labels bgp_labels = {};
 	route_map_result_t ret;
 	struct route_map *rmap = NULL;
+	struct attr *parsed_attr;
+	struct bgp_rmap_memo **memo;
 
 	filter = &peer->filter[afi][safi];
 
@@ -2119,8 +2124,19 @@ static int bgp_input_modifier(struct peer *peer, const struct prefix *p,
 
 		SET_FLAG(peer->rmap_type, PEER_RMAP_TYPE_IN);
 
-		/* Apply BGP route map to the attribute. */
-		ret = route_map_apply(rmap, p, &rmap_path);
+		/* Apply BGP route map to the attribute.  The prefixes of one
+		 * UPDATE share the parsed attr, so a route-map that does not
+		 * look at the prefix only needs to run once for all of them.
+		 */
+		parsed_attr = attr->attr_intern_reuse.parsed_attr;
+		if (parsed_attr) {
+			memo = &parsed_attr->attr_intern_reuse.rmap_memo;
+			if (!*memo)
+				*memo = bgp_rmap_memo_new();
+			ret = bgp_route_map_apply_memo(*memo, rmap, p,
+						       &rmap_path, peer);
+		} else
+			ret = route_map_apply(rmap, p, &rmap_path);
 
 		peer->rmap_type = 0;
 
@@ -2846,6 +2862,10 @@ bool subgroup_announce_check(struct bgp_dest *dest, struct bgp_path_info *pi,
 		if (bgp_path_suppressed(pi))
 			ret = route_map_apply(UNSUPPRESS_MAP(filter), p,
 					      &rmap_path);
+		else if (subgrp->rmap_memo)
+			ret = bgp_route_map_apply_memo(subgrp->rmap_memo,
+						       ROUTE_MAP_OUT(filter), p,
+						       &rmap_path, from);
 		else
 			ret = route_map_apply(ROUTE_MAP_OUT(filter), p,
 					      &rmap_path);
@@ -3154,7 +3174,7 @@ bool subgroup_announce_check(struct bgp_dest *dest, struct bgp_path_info *pi,
 				bgp_attr_set_aigp_metric(attr, aigp);
 			}
 		} else {
-			attr->aigp_metric = 0;
+			bgp_attr_set_aigp_metric(attr, 0);
 			bgp_attr_unset(attr, BGP_ATTR_AIGP);
 		}
 	}
@@ -3268,7 +3288,7 @@ void bgp_best_selection(struct bgp *bgp, struct bgp_dest *dest,
 	struct bgp_path_info *pi1;
 	struct bgp_path_info *pi2;
 	int paths_eq, do_mpath;
-	bool debug, any_comparisons;
+	bool debug, any_comparisons, incremental;
 	char pfx_buf[PREFIX2STR_BUFFER] = {};
 	char path_buf[PATH_ADDPATH_STR_BUFFER];
 	enum bgp_path_selection_reason reason = bgp_path_selection_none;
@@ -3408,10 +3428,55 @@ void bgp_best_selection(struct bgp *bgp, struct bgp_dest *dest,
 			old_select = NULL;
 	}
 
+	/*
+	 * As long as the best path is still at the head of the list and
+	 * usable, an unsorted path only needs to be compared against it.
+	 * Otherwise the paths placed lazily behind the old best have to go
+	 * through the full sort again.
+	 */
+	incremental = !CHECK_FLAG(bgp->flags, BGP_FLAG_DETERMINISTIC_MED) && old_select &&
+		      old_select == bgp_dest_get_bgp_path_info(dest) &&
+		      !BGP_PATH_HOLDDOWN(old_select);
+
+	if (!incremental && CHECK_FLAG(dest->flags, BGP_NODE_LAZY_SORTED)) {
+		struct bgp_path_info *next;
+
+		for (pi = bgp_dest_get_bgp_path_info(dest); pi; pi = next) {
+			next = pi->next;
+
+			if (!CHECK_FLAG(pi->flags, BGP_PATH_LAZY_SORTED))
+				continue;
+
+			UNSET_FLAG(pi->flags, BGP_PATH_LAZY_SORTED);
+
+			if (pi->next)
+				pi->next->prev = pi->prev;
+			if (pi->prev)
+				pi->prev->next = pi->next;
+			else
+				bgp_dest_set_bgp_path_info(dest, pi->next);
+
+			pi->next = NULL;
+			pi->prev = unsorted_list_spot;
+			if (unsorted_list_spot)
+				unsorted_list_spot->next = pi;
+			else
+				unsorted_list = pi;
+			unsorted_list_spot = pi;
+		}
+
+		UNSET_FLAG(dest->flags, BGP_NODE_LAZY_SORTED);
+	}
+
 	if (!unsorted_list)
 		unsorted_items = true;
-	else
+	else {
 		unsorted_items = false;
+		if (incremental)
+			bgp->bestpath_incremental++;
+		else
+			bgp->bestpath_full++;
+	}
 
 	any_comparisons = false;
 	worse = NULL;
@@ -3423,6 +3488,7 @@ void bgp_best_selection(struct bgp *bgp, struct bgp_dest *dest,
 			unsorted_list->prev = NULL;
 		first->next = NULL;
 		first->prev = NULL;
+		UNSET_FLAG(first->flags, BGP_PATH_LAZY_SORTED);
 
 		/*
 		 * It's not likely that the just received unsorted entry
@@ -3487,6 +3553,35 @@ void bgp_best_selection(struct bgp *bgp, struct bgp_dest *dest,
 
 		bgp_path_info_unset_flag(dest, first, BGP_PATH_DMED_CHECK);
 
+		if (incremental) {
+			struct bgp_path_info *best = bgp_dest_get_bgp_path_info(dest);
+
+			reason = dest->reason;
+			any_comparisons = true;
+			if (bgp_path_info_cmp(bgp, first, best, &paths_eq, mpath_cfg, debug,
+					      pfx_buf, afi, safi, &reason)) {
+				/* new best path, the rest stays as it is */
+				first->reason = reason;
+				first->next = best;
+				best->prev = first;
+				bgp_dest_set_bgp_path_info(dest, first);
+				dest->reason = first->reason;
+			} else {
+				/* park it right behind the best path */
+				best->reason = reason;
+				first->prev = best;
+				first->next = best->next;
+				if (best->next)
+					best->next->prev = first;
+				best->next = first;
+				SET_FLAG(first->flags, BGP_PATH_LAZY_SORTED);
+				SET_FLAG(dest->flags, BGP_NODE_LAZY_SORTED);
+			}
+
+			UNSET_FLAG(first->flags, BGP_PATH_UNSORTED);
+			continue;
+		}
+
 		worse = NULL;
 
 		struct bgp_path_info *look_thru_next;
@@ -3898,9 +3993,11 @@ static void bgp_process_evpn_route_injection(struct bgp *bgp, afi_t afi,
 				 */
 				bgp_evpn_withdraw_type5_route(bgp, old_select, p, afi, safi, 0);
 				bgp_evpn_withdraw_type5_route(bgp, new_select, p, afi, safi, 0);
-			} else
+			} else {
 				bgp_evpn_advertise_type5_route(bgp, new_select, p, &dummy_attr,
 							       afi, safi, 0);
+				bgp_attr_ext_flush(&dummy_attr);
+			}
 		} else {
 			bgp_evpn_advertise_type5_route(bgp, new_select, p, new_select->attr, afi,
 						       safi, 0);
@@ -4830,7 +4927,7 @@ static void process_eoiu_marker(struct bgp_dest *dest)
 	bgp_process_main_one(info->bgp, NULL, 0, 0);
 
 	XFREE(MTYPE_BGP_EOIU_MARKER_INFO, info);
-	XFREE(MTYPE_BGP_NODE, dest);
+	XPOOL_FREE(BGP_NODE, dest);
 }
 
 /*
@@ -4861,14 +4958,24 @@ static unsigned int process_subq(struct bgp_dest_queue *subq, enum meta_queue_in
 	return 1;
 }
 
-/* Dispatch the meta queue by picking and processing the next node from
- * a non-empty sub-queue with lowest priority. wq is equal to bgp->process_queue and
- * data is pointed to the meta queue structure.
+/*
+ * Number of nodes dispatched per meta queue run.  The peer fifo check
+ * below takes a mutex shared with the I/O pthreads, so don't pay for it
+ * (and for the work queue round trip) on every single node.
+ */
+#define BGP_META_QUEUE_BATCH 32
+
+/* Dispatch the meta queue by picking and processing the next nodes from
+ * the non-empty sub-queue with lowest priority, up to BGP_META_QUEUE_BATCH
+ * of them.  The sub-queues are re-examined for every node, so nodes queued
+ * with a higher priority while the batch runs are still handled first.
+ * wq is equal to bgp->process_queue and data is pointed to the meta queue
+ * structure.
  */
 static wq_item_status meta_queue_process(struct work_queue *dummy, void *data)
 {
 	struct meta_queue *mq = data;
-	uint32_t i;
+	uint32_t i, n;
 	uint32_t peers_on_fifo;
 	static uint32_t total_runs = 0;
 
@@ -4887,11 +4994,12 @@ static wq_item_status meta_queue_process(struct work_queue *dummy, void *data)
 	if (peers_on_fifo > 10 && total_runs % 10 != 0)
 		return WQ_QUEUE_BLOCKED;
 
-	for (i = 0; i < MQ_SIZE; i++)
-		if (process_subq(mq->subq[i], i)) {
-			mq->size--;
-			break;
-		}
+	for (n = 0; n < BGP_META_QUEUE_BATCH && mq->size; n++)
+		for (i = 0; i < MQ_SIZE; i++)
+			if (process_subq(mq->subq[i], i)) {
+				mq->size--;
+				break;
+			}
 
 	return mq->size ? WQ_REQUEUE : WQ_SUCCESS;
 }
@@ -5049,7 +5157,7 @@ static void eoiu_marker_queue_free(struct meta_queue *mq, struct bgp_dest_queue
 		XFREE(MTYPE_BGP_EOIU_MARKER_INFO, dest->info);
 		STAILQ_REMOVE_HEAD(l, pq);
 		STAILQ_NEXT(dest, pq) = NULL; /* complete unlink */
-		XFREE(MTYPE_BGP_NODE, dest);
+		XPOOL_FREE(BGP_NODE, dest);
 		mq->size--;
 	}
 }
@@ -5179,7 +5287,7 @@ void bgp_add_eoiu_mark(struct bgp *bgp)
 	 * Create a dummy dest as the meta queue expects all its elements to be
 	 * dest's
 	 */
-	struct bgp_dest *dummy_dest = XCALLOC(MTYPE_BGP_NODE, sizeof(struct bgp_dest));
+	struct bgp_dest *dummy_dest = XPOOL_CALLOC(BGP_NODE);
 
 	struct bgp_eoiu_info *eoiu_info = XCALLOC(MTYPE_BGP_EOIU_MARKER_INFO,
 						  sizeof(struct bgp_eoiu_info));
@@ -5432,7 +5540,7 @@ struct bgp_path_info *info_make(int type, int sub_type, unsigned short instance,
 	struct bgp_path_info *new;
 
 	/* Make new BGP info. */
-	new = XCALLOC(MTYPE_BGP_ROUTE, sizeof(struct bgp_path_info));
+	new = XPOOL_CALLOC(BGP_ROUTE);
 	new->type = type;
 	new->instance = instance;
 	new->sub_type = sub_type;
@@ -6541,7 +6649,7 @@ filtered:
 		bgp_unlink_nexthop(new);
 		bgp_path_info_mark_for_delete(dest, new);
 		bgp_path_info_extra_free(&new->extra);
-		XFREE(MTYPE_BGP_ROUTE, new);
+		XPOOL_FREE(BGP_ROUTE, new);
 	}
 
 	hook_call(bgp_process, bgp, afi, safi, dest, peer, true);
@@ -8096,10 +8204,8 @@ bool bgp_addpath_encode_rx(struct peer *peer, afi_t afi, safi_t safi)
 			      PEER_CAP_ADDPATH_AF_TX_RCV));
 }
 
-/* Parse NLRI stream.  Withdraw NLRI is recognized by NULL attr
-   value. */
-int bgp_nlri_parse_ip(struct peer *peer, struct attr *attr,
-		      struct bgp_nlri *packet)
+static int bgp_nlri_parse_ip_prefixes(struct peer *peer, struct attr *attr,
+				      struct bgp_nlri *packet)
 {
 	uint8_t *pnt;
 	uint8_t *lim;
@@ -8117,11 +8223,6 @@ int bgp_nlri_parse_ip(struct peer *peer, struct attr *attr,
 	addpath_id = 0;
 	addpath_capable = bgp_addpath_encode_rx(peer, afi, safi);
 
-	/* cache the incoming attr to avoid repeated intern */
-	if (attr) {
-		memset(&attr->attr_intern_reuse, 0, sizeof(attr->attr_intern_reuse));
-		attr->attr_intern_reuse.parsed_attr = attr;
-	}
 	/* RFC4271 6.3 The NLRI field in the UPDATE message is checked for
 	   syntactic validity.  If the field is syntactically incorrect,
 	   then the Error Subcode is set to Invalid Network Field. */
@@ -8236,10 +8337,6 @@ int bgp_nlri_parse_ip(struct peer *peer, struct attr *attr,
 			return BGP_NLRI_PARSE_ERROR_PREFIX_OVERFLOW;
 	}
 
-	/* Reset the attr_intern_reuse cache */
-	if (attr)
-		memset(&attr->attr_intern_reuse, 0, sizeof(attr->attr_intern_reuse));
-
 	/* Packet length consistency check. */
 	if (pnt != lim) {
 		flog_err(
@@ -8252,6 +8349,32 @@ int bgp_nlri_parse_ip(struct peer *peer, struct attr *attr,
 	return BGP_NLRI_PARSE_OK;
 }
 
+/* Parse NLRI stream.  Withdraw NLRI is recognized by NULL attr
+   value. */
+int bgp_nlri_parse_ip(struct peer *peer, struct attr *attr,
+		      struct bgp_nlri *packet)
+{
+	int ret;
+
+	/* cache the incoming attr to avoid repeated intern */
+	if (attr) {
+		memset(&attr->attr_intern_reuse, 0, sizeof(attr->attr_intern_reuse));
+		attr->attr_intern_reuse.parsed_attr = attr;
+	}
+
+	ret = bgp_nlri_parse_ip_prefixes(peer, attr, packet);
+
+	/* Reset the attr_intern_reuse cache, including the inbound
+	 * route-map results kept for these prefixes.
+	 */
+	if (attr) {
+		bgp_rmap_memo_free(&attr->attr_intern_reuse.rmap_memo);
+		memset(&attr->attr_intern_reuse, 0, sizeof(attr->attr_intern_reuse));
+	}
+
+	return ret;
+}
+
 static void bgp_nexthop_reachability_check(afi_t afi, safi_t safi,
 					   struct bgp_path_info *bpi,
 					   const struct prefix *p,
@@ -12284,10 +12407,10 @@ static void route_vty_out_detail_es_info(struct vty *vty,
 			if (peer_router)
 				json_object_boolean_true_add(
 						json_es_info, "peerRouter");
-			if (attr->mm_sync_seqnum)
+			if (bgp_evpn_attr_get_sync_seq(attr))
 				json_object_int_add(
 						json_es_info, "peerSeq",
-						attr->mm_sync_seqnum);
+						bgp_evpn_attr_get_sync_seq(attr));
 			json_object_object_add(
 					json_path, "es_info",
 					json_es_info);
@@ -12301,7 +12424,7 @@ static void route_vty_out_detail_es_info(struct vty *vty,
 					peer_proxy ? "proxy " : "",
 					peer_active ? "active ":"",
 					peer_router ? "router ":"",
-					attr->mm_sync_seqnum);
+					bgp_evpn_attr_get_sync_seq(attr));
 		else
 			vty_out(vty, "      ESI %s %s\n",
 					esi_buf,
@@ -13389,6 +13512,8 @@ void route_vty_out_detail(struct vty *vty, struct bgp *bgp, struct bgp_dest *bn,
 
 	/* Line 10 display PMSI tunnel attribute, if present */
 	if (CHECK_FLAG(attr->flag, ATTR_FLAG_BIT(BGP_ATTR_PMSI_TUNNEL))) {
+		const struct in6_addr *tunn_id = bgp_attr_get_pmsi_tunn_id(attr);
+
 		msgstr = lookup_msg(bgp_pmsi_tnltype_str, bgp_attr_get_pmsi_tnl_type(attr),
 				    PMSI_TNLTYPE_STR_DEFAULT);
 
@@ -13399,25 +13524,25 @@ void route_vty_out_detail(struct vty *vty, struct bgp *bgp, struct bgp_dest *bn,
 					    label2vni(&attr->label));
 
 			if (bgp_attr_get_pmsi_tnl_type(attr) == PMSI_TNLTYPE_INGR_REPL) {
-				if (IS_MAPPED_IPV6(&attr->tunn_id)) {
+				if (IS_MAPPED_IPV6(tunn_id)) {
 					json_object_string_addf(
 						json_pmsi, "id", "%pI4",
-						(in_addr_t *)&attr->tunn_id.s6_addr32[3]);
+						(in_addr_t *)&tunn_id->s6_addr32[3]);
 				} else {
 					json_object_string_addf(json_pmsi, "id", "%pI6",
-								&attr->tunn_id);
+								tunn_id);
 				}
 			}
 			json_object_object_add(json_path, "pmsi", json_pmsi);
 		} else if (bgp_attr_get_pmsi_tnl_type(attr) == PMSI_TNLTYPE_INGR_REPL) {
 			/* Include tunnel ID for known types */
-			if (IS_MAPPED_IPV6(&attr->tunn_id)) {
+			if (IS_MAPPED_IPV6(tunn_id)) {
 				vty_out(vty, "      PMSI Tunnel Type: %s, label: %d ID:%pI4\n",
 					msgstr, label2vni(&attr->label),
-					(in_addr_t *)&attr->tunn_id.s6_addr32[3]);
+					(in_addr_t *)&tunn_id->s6_addr32[3]);
 			} else {
 				vty_out(vty, "      PMSI Tunnel Type: %s, label: %d ID:%pI6\n",
-					msgstr, label2vni(&attr->label), &attr->tunn_id);
+					msgstr, label2vni(&attr->label), tunn_id);
 			}
 		} else {
 			/* Label only */
@@ -16099,6 +16224,8 @@ static int bgp_table_stats_single(struct vty *vty, struct bgp *bgp, afi_t afi,
 
 	if (json) {
 		json_object_int_add(json, "bgpBestPathCalls", bgp->bestpath_runs);
+		json_object_int_add(json, "bgpBestPathIncremental", bgp->bestpath_incremental);
+		json_object_int_add(json, "bgpBestPathFull", bgp->bestpath_full);
 		json_object_int_add(json, "bgpNodeOnQueue", bgp->node_already_on_queue);
 		json_object_int_add(json, "bgpNodeDeferredOnQueue", bgp->node_deferred_on_queue);
 	}
@@ -16276,10 +16403,13 @@ static int bgp_table_stats_single(struct vty *vty, struct bgp *bgp, afi_t afi,
 			vty_out(vty, "\n");
 	}
 
-	if (!json)
+	if (!json) {
 		vty_out(vty, "%-30s: %12u\n", "Zebra announce queue",
 			bgp->zebra_announce_queue_cnt);
-	else
+		vty_out(vty, "%-30s: %12" PRIu64 "\n", "Incremental bestpath runs",
+			bgp->bestpath_incremental);
+		vty_out(vty, "%-30s: %12" PRIu64 "\n", "Full bestpath runs", bgp->bestpath_full);
+	} else
 		json_object_int_add(json, "zebraAnnounceQueue", bgp->zebra_announce_queue_cnt);
 
 	switch (afi) {
@@ -17088,6 +17218,10 @@ static void show_adj_route(struct vty *vty, struct peer *peer, struct bgp_table
 				(*output_count)++;
 			}
 		}
+
+		/* write out this dest's entries if json_ar is streamed */
+		if (use_json)
+			frr_json_vty_flush(vty, json_ar);
 	}
 }
 
@@ -17136,6 +17270,7 @@ static int peer_adj_routes_brief(struct vty *vty, struct peer *peer, afi_t afi,
 	}
 
 	json_prefix = json_object_new_object();
+	frr_json_set_open(json_prefix);
 	bgp = peer->bgp;
 
 	/* labeled-unicast routes live in the unicast table */
@@ -17226,8 +17361,11 @@ static int peer_adj_routes_brief(struct vty *vty, struct peer *peer, afi_t afi,
 			/* e.g. bgp_show_adj_route_filtered: no per-prefix brief JSON here */
 			continue;
 		}
+
+		frr_json_vty_flush(vty, json_prefix);
 	}
-	vty_json_no_pretty(vty, json_prefix); /* Free's all the JSON's associted with prefix */
+	frr_json_set_complete(json_prefix);
+	frr_json_vty_out_bare(vty, json_prefix); /* Free's all the JSON's associted with prefix */
 	return CMD_SUCCESS;
 }
 
@@ -17419,6 +17557,14 @@ static int peer_adj_routes(struct vty *vty, struct peer *peer, afi_t afi, safi_t
 		if (first == false && json_routes)
 			vty_out(vty, "}");
 	} else {
+		/*
+		 * Advertised and received routes go straight out to the vty
+		 * while walking the table instead of piling up in json_ar.
+		 */
+		if (use_json &&
+		    (type == bgp_show_adj_route_advertised || type == bgp_show_adj_route_received))
+			frr_json_set_open(json_ar);
+
 		show_adj_route(vty, peer, table, afi, safi, type, rmap_name, json, json_ar,
 			       show_flags, &header1, &header2, rd_str, match, &output_count,
 			       &filtered_count, &paths_count);
@@ -17426,7 +17572,8 @@ static int peer_adj_routes(struct vty *vty, struct peer *peer, afi_t afi, safi_t
 		if (use_json) {
 			if (type == bgp_show_adj_route_advertised ||
 			    type == bgp_show_adj_route_received) {
-				vty_json_no_pretty(vty, json_ar);
+				frr_json_set_complete(json_ar);
+				frr_json_vty_out_bare(vty, json_ar);
 			}
 		}
 	}
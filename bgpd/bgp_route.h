@@ -352,6 +352,13 @@ struct bgp_path_info {
  * the actual ecmp path.
  */
 #define BGP_PATH_MULTIPATH_NEW (1 << 20)
+/*
+ * BGP_PATH_LAZY_SORTED is set on paths that incremental best path
+ * selection only compared against the best path.  They sit right
+ * behind it in the path list in no particular order and are sorted
+ * properly once the best path changes.
+ */
+#define BGP_PATH_LAZY_SORTED (1 << 21)
 
 	/* BGP route type.  This can be static, RIP, OSPF, BGP etc.  */
 	uint8_t type;
@@ -688,6 +695,19 @@ static inline void prep_for_rmap_apply(struct bgp_path_info *dst_pi,
 	}
 }
 
+/* Route-map result memoization, see bgp_routemap.c */
+#define BGP_RMAP_MEMO_MAX 4096
+
+struct bgp_rmap_memo;
+extern struct bgp_rmap_memo *bgp_rmap_memo_new(void);
+extern void bgp_rmap_memo_free(struct bgp_rmap_memo **memo);
+extern unsigned long bgp_rmap_memo_count(const struct bgp_rmap_memo *memo);
+extern route_map_result_t bgp_route_map_apply_memo(struct bgp_rmap_memo *memo,
+						   struct route_map *map,
+						   const struct prefix *p,
+						   struct bgp_path_info *path,
+						   struct peer *from);
+
 static inline bool bgp_check_advertise(struct bgp *bgp, struct bgp_dest *dest,
 				       safi_t safi)
 {
@@ -1018,6 +1038,9 @@ extern bool bgp_path_suppressed(struct bgp_path_info *pi);
 extern bool bgp_addpath_encode_rx(struct peer *peer, afi_t afi, safi_t safi);
 extern const struct prefix_rd *bgp_rd_from_dest(const struct bgp_dest *dest,
 						safi_t safi);
+/* bgp_path_info is allocated from this pool, see info_make() */
+DECLARE_MPOOL(BGP_ROUTE);
+
 extern void bgp_path_info_free_with_caller(const char *caller,
 					   struct bgp_path_info *path);
 extern void bgp_path_info_add_with_caller(const char *caller,
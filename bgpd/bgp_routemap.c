@@ -148,7 +148,7 @@ static uint32_t route_value_adjust(struct rmap_value *rv, uint32_t current,
 		value = bpi->extra ? bpi->extra->igpmetric : 0;
 		break;
 	case RMAP_VALUE_TYPE_AIGP:
-		value = MIN(bpi->attr->aigp_metric, UINT32_MAX);
+		value = MIN(bgp_attr_get_aigp_metric(bpi->attr), UINT32_MAX);
 		break;
 	default:
 		value = rv->value;
@@ -5107,6 +5107,377 @@ bool bgp_route_map_has_extcommunity_rt(const struct route_map *map)
 	return false;
 }
 
+/*
+ * Route-map result memoization.
+ *
+ * Most route-maps only look at path attributes, yet they are applied once
+ * per prefix.  Within the prefixes of one UPDATE (inbound) or one table
+ * walk for a subgroup (outbound) neither the peer nor the configuration
+ * changes, so the result of a route-map that does not look at the prefix
+ * only depends on the input attr and the source peer, and can be reused
+ * for every prefix sharing them.  A memo is only ever kept for the
+ * duration of such a walk, so it never needs to be invalidated.
+ */
+
+/* An invocation counter bumped by applying a route-map once */
+struct bgp_rmap_memo_count {
+	uint64_t *applied;
+	uint64_t delta;
+};
+
+struct bgp_rmap_memo_entry {
+	struct route_map *map;
+	struct peer *from;
+
+	/* Interned input attr, and the interned result of applying map to
+	 * it (NULL if denied).
+	 */
+	struct attr *in;
+	struct attr *out;
+	route_map_result_t ret;
+
+	/* Counters route_map_apply() bumped for this input, which a hit
+	 * bumps alike so that "show route-map" does not depend on the memo.
+	 */
+	unsigned int ncounts;
+	struct bgp_rmap_memo_count counts[];
+};
+
+struct bgp_rmap_memo {
+	struct hash *hash;
+
+	/* Last route-map looked at, and whether it can be memoized */
+	struct route_map *map;
+	bool memoizable;
+
+	/* Invocation counters of map, its indexes and the route-maps they
+	 * call, with their values before the last route_map_apply().
+	 */
+	uint64_t **counters;
+	uint64_t *before;
+	unsigned int ncounters;
+	unsigned int counters_size;
+};
+
+/* Match and set commands that neither look at the prefix nor at the path
+ * beyond its attributes and peers.
+ */
+static const char *const bgp_rmap_memo_match_cmds[] = {
+	"peer",
+	"ip next-hop",
+	"ip next-hop prefix-list",
+	"ip next-hop type",
+	"ip route-source",
+	"ip route-source prefix-list",
+	"ipv6 next-hop",
+	"ipv6 next-hop prefix-list",
+	"ipv6 next-hop type",
+	"community-limit",
+	"extcommunity-limit",
+	"alias",
+	"local-preference",
+	"metric",
+	"as-path",
+	"as-path-count",
+	"community",
+	"large-community",
+	"extcommunity",
+	"origin",
+	"tag",
+	"rpki-extcommunity",
+	NULL,
+};
+
+static const char *const bgp_rmap_memo_set_cmds[] = {
+	"ip next-hop",
+	"local-preference",
+	"weight",
+	"distance",
+	"metric",
+	"table",
+	"as-path prepend",
+	"as-path exclude",
+	"as-path replace",
+	"community",
+	"large-community",
+	"large-comm-list",
+	"comm-list",
+	"extended-comm-list",
+	"extcommunity rt",
+	"extcommunity soo",
+	"extcommunity nt",
+	"extcommunity color",
+	"origin",
+	"atomic-aggregate",
+	"aigp-metric",
+	"aggregator as",
+	"tag",
+	"label-index",
+	"ipv6 next-hop global",
+	"ipv6 next-hop prefer-global",
+	"ipv6 next-hop local",
+	"ipv6 next-hop peer-address",
+	"ipv4 vpn next-hop",
+	"ipv6 vpn next-hop",
+	"originator-id",
+	NULL,
+};
+
+static bool bgp_rmap_memo_rules_ok(const struct route_map_rule_list *rules,
+				   const char *const *cmds, bool set)
+{
+	const struct route_map_rule *rule;
+	int i;
+
+	for (rule = rules->head; rule; rule = rule->next) {
+		if (!rule->cmd || !rule->cmd->str)
+			return false;
+
+		for (i = 0; cmds[i]; i++)
+			if (strmatch(rule->cmd->str, cmds[i]))
+				break;
+		if (!cmds[i])
+			return false;
+
+		/* set metric igp / aigp-metric igp-metric use the path's
+		 * IGP metric, which differs between prefixes.
+		 */
+		if (set && rule->rule_str && strstr(rule->rule_str, "igp"))
+			return false;
+	}
+
+	return true;
+}
+
+static bool bgp_route_map_memoizable(struct route_map *map, int depth)
+{
+	struct route_map_index *index;
+	struct route_map *nextrm;
+
+	if (depth > RMAP_RECURSION_LIMIT)
+		return false;
+
+	for (index = map->head; index; index = index->next) {
+		if (!bgp_rmap_memo_rules_ok(&index->match_list,
+					    bgp_rmap_memo_match_cmds, false) ||
+		    !bgp_rmap_memo_rules_ok(&index->set_list,
+					    bgp_rmap_memo_set_cmds, true))
+			return false;
+
+		if (index->nextrm) {
+			nextrm = route_map_lookup_by_name(index->nextrm);
+			if (nextrm && !bgp_route_map_memoizable(nextrm, depth + 1))
+				return false;
+		}
+	}
+
+	return true;
+}
+
+static void bgp_rmap_memo_add_counter(struct bgp_rmap_memo *memo,
+				      uint64_t *applied)
+{
+	if (memo->ncounters == memo->counters_size) {
+		memo->counters_size = memo->counters_size ? memo->counters_size * 2 : 8;
+		memo->counters = XREALLOC(MTYPE_BGP_RMAP_MEMO, memo->counters,
+					  memo->counters_size * sizeof(*memo->counters));
+		memo->before = XREALLOC(MTYPE_BGP_RMAP_MEMO, memo->before,
+					memo->counters_size * sizeof(*memo->before));
+	}
+
+	memo->counters[memo->ncounters++] = applied;
+}
+
+static void bgp_rmap_memo_add_counters(struct bgp_rmap_memo *memo,
+				       struct route_map *map, int depth)
+{
+	struct route_map_index *index;
+	struct route_map *nextrm;
+	unsigned int i;
+
+	if (depth > RMAP_RECURSION_LIMIT)
+		return;
+
+	/* A route-map called from more than one index is only added once */
+	for (i = 0; i < memo->ncounters; i++)
+		if (memo->counters[i] == &map->applied)
+			return;
+
+	bgp_rmap_memo_add_counter(memo, &map->applied);
+
+	for (index = map->head; index; index = index->next) {
+		bgp_rmap_memo_add_counter(memo, &index->applied);
+
+		if (index->nextrm) {
+			nextrm = route_map_lookup_by_name(index->nextrm);
+			if (nextrm)
+				bgp_rmap_memo_add_counters(memo, nextrm,
+							   depth + 1);
+		}
+	}
+}
+
+static unsigned int bgp_rmap_memo_hash_key(const void *p)
+{
+	const struct bgp_rmap_memo_entry *entry = p;
+
+	return jhash_3words(attrhash_key_make(entry->in),
+			    (uint32_t)(uintptr_t)entry->map,
+			    (uint32_t)(uintptr_t)entry->from, 0);
+}
+
+static bool bgp_rmap_memo_hash_cmp(const void *p1, const void *p2)
+{
+	const struct bgp_rmap_memo_entry *e1 = p1;
+	const struct bgp_rmap_memo_entry *e2 = p2;
+
+	return e1->map == e2->map && e1->from == e2->from &&
+	       attrhash_cmp(e1->in, e2->in);
+}
+
+static void bgp_rmap_memo_entry_free(void *arg)
+{
+	struct bgp_rmap_memo_entry *entry = arg;
+
+	bgp_attr_unintern(&entry->in);
+	if (entry->out)
+		bgp_attr_unintern(&entry->out);
+	XFREE(MTYPE_BGP_RMAP_MEMO, entry);
+}
+
+struct bgp_rmap_memo *bgp_rmap_memo_new(void)
+{
+	struct bgp_rmap_memo *memo;
+
+	memo = XCALLOC(MTYPE_BGP_RMAP_MEMO, sizeof(*memo));
+	memo->hash = hash_create(bgp_rmap_memo_hash_key, bgp_rmap_memo_hash_cmp,
+				 "BGP route-map memo");
+
+	return memo;
+}
+
+void bgp_rmap_memo_free(struct bgp_rmap_memo **memo)
+{
+	if (!*memo)
+		return;
+
+	hash_clean_and_free(&(*memo)->hash, bgp_rmap_memo_entry_free);
+	XFREE(MTYPE_BGP_RMAP_MEMO, (*memo)->counters);
+	XFREE(MTYPE_BGP_RMAP_MEMO, (*memo)->before);
+	XFREE(MTYPE_BGP_RMAP_MEMO, *memo);
+}
+
+unsigned long bgp_rmap_memo_count(const struct bgp_rmap_memo *memo)
+{
+	return memo->hash->count;
+}
+
+/* Intern attr in place, keeping it out of the UPDATE's intern reuse */
+static struct attr *bgp_rmap_memo_intern(struct attr *attr)
+{
+	struct bgp_rmap_memo *rmap_memo = attr->attr_intern_reuse.rmap_memo;
+	struct attr *parsed_attr = attr->attr_intern_reuse.parsed_attr;
+	struct attr *ret;
+
+	attr->attr_intern_reuse.parsed_attr = NULL;
+	ret = bgp_attr_intern(attr);
+	attr->attr_intern_reuse.parsed_attr = parsed_attr;
+	attr->attr_intern_reuse.rmap_memo = rmap_memo;
+
+	return ret;
+}
+
+/* route_map_apply(), reusing the result for an earlier path with the same
+ * attributes and source peer when map allows it.
+ */
+route_map_result_t bgp_route_map_apply_memo(struct bgp_rmap_memo *memo,
+					    struct route_map *map,
+					    const struct prefix *p,
+					    struct bgp_path_info *path,
+					    struct peer *from)
+{
+	struct bgp_rmap_memo_entry lookup = {};
+	struct bgp_rmap_memo_entry *entry;
+	struct attr *attr = path->attr;
+	struct attr in;
+	route_map_result_t ret;
+	unsigned int ncounts;
+	unsigned int i;
+
+	if (memo->map != map) {
+		memo->map = map;
+		memo->memoizable = bgp_route_map_memoizable(map, 0);
+		memo->ncounters = 0;
+		if (memo->memoizable)
+			bgp_rmap_memo_add_counters(memo, map, 0);
+	}
+
+	if (!memo->memoizable || !bgp_attr_subs_interned(attr))
+		return route_map_apply(map, p, path);
+
+	lookup.map = map;
+	lookup.from = from;
+	lookup.in = attr;
+	entry = hash_lookup(memo->hash, &lookup);
+	if (entry) {
+		for (i = 0; i < entry->ncounts; i++)
+			*entry->counts[i].applied += entry->counts[i].delta;
+
+		if (entry->out) {
+			/* Not part of attrhash_cmp(), and left alone by
+			 * memoizable route-maps.
+			 */
+			in = *attr;
+			*attr = *entry->out;
+			attr->refcnt = 0;
+			attr->label = in.label;
+			attr->evpn_flags = in.evpn_flags;
+			attr->attr_intern_reuse = in.attr_intern_reuse;
+		}
+
+		return entry->ret;
+	}
+
+	for (i = 0; i < memo->ncounters; i++)
+		memo->before[i] = *memo->counters[i];
+
+	in = *attr;
+	ret = route_map_apply(map, p, path);
+
+	/* Start over rather than keep growing past the limit */
+	if (memo->hash->count >= BGP_RMAP_MEMO_MAX)
+		hash_clean(memo->hash, bgp_rmap_memo_entry_free);
+
+	ncounts = 0;
+	for (i = 0; i < memo->ncounters; i++)
+		if (*memo->counters[i] != memo->before[i])
+			ncounts++;
+
+	/* The input only references interned objects, which the route-map
+	 * cannot have freed, so the copy is still good to intern.
+	 */
+	entry = XCALLOC(MTYPE_BGP_RMAP_MEMO,
+			sizeof(*entry) + ncounts * sizeof(entry->counts[0]));
+	for (i = 0; i < memo->ncounters; i++) {
+		if (*memo->counters[i] == memo->before[i])
+			continue;
+
+		entry->counts[entry->ncounts].applied = memo->counters[i];
+		entry->counts[entry->ncounts].delta =
+			*memo->counters[i] - memo->before[i];
+		entry->ncounts++;
+	}
+	entry->map = map;
+	entry->from = from;
+	entry->in = bgp_rmap_memo_intern(&in);
+	entry->ret = ret;
+	if (ret != RMAP_DENYMATCH)
+		entry->out = bgp_rmap_memo_intern(attr);
+	(void)hash_get(memo->hash, entry, hash_alloc_intern);
+
+	return ret;
+}
+
 static void bgp_route_map_event(const char *rmap_name)
 {
 	if (route_map_mark_updated(rmap_name) == 0)
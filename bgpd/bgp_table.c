@@ -20,6 +20,8 @@
 #include "bgp_mpath.h"
 #include "bgp_ls.h"
 
+DEFINE_MPOOL(BGP_NODE, BGP_NODE, sizeof(struct bgp_dest));
+
 void bgp_table_lock(struct bgp_table *rt)
 {
 	rt->lock++;
@@ -106,7 +108,7 @@ inline struct bgp_dest *bgp_dest_unlock_node(struct bgp_dest *dest)
 			bgp_ls_nlri_free(dest->ls_nlri);
 		}
 
-		XFREE(MTYPE_BGP_NODE, dest);
+		XPOOL_FREE(BGP_NODE, dest);
 		dest = NULL;
 		route_node_set_info(rn, NULL);
 	}
@@ -136,7 +138,7 @@ static void bgp_node_destroy(route_table_delegate_t *delegate,
 		if (dest->mpath)
 			bgp_path_info_mpath_free(&dest->mpath);
 
-		XFREE(MTYPE_BGP_NODE, dest);
+		XPOOL_FREE(BGP_NODE, dest);
 		route_node_set_info(node, NULL);
 	}
 
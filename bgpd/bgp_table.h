@@ -113,6 +113,7 @@ struct bgp_dest {
 #define BGP_NODE_SCHEDULE_FOR_DELETE	(1 << 11)
 #define BGP_NODE_NHT_RESOLVED_NODE	(1 << 12)
 #define BGP_NODE_ZEBRA_ANNOUNCE_EARLY	(1 << 13)
+#define BGP_NODE_LAZY_SORTED		(1 << 14)
 
 	struct bgp_addpath_node_data tx_addpath;
 
@@ -124,6 +125,8 @@ struct bgp_dest {
 
 DECLARE_LIST(zebra_announce, struct bgp_bp_install_node, zai);
 
+DECLARE_MPOOL(BGP_NODE);
+
 extern void bgp_delete_listnode(struct bgp_dest *dest);
 /*
  * bgp_table_iter_t
@@ -263,8 +266,7 @@ static inline struct bgp_dest *bgp_node_get(struct bgp_table *const table,
 	struct route_node *rn = route_node_get(table->route_table, p);
 
 	if (!rn->info) {
-		struct bgp_dest *dest = XCALLOC(MTYPE_BGP_NODE,
-						sizeof(struct bgp_dest));
+		struct bgp_dest *dest = XPOOL_CALLOC(BGP_NODE);
 
 		RB_INIT(bgp_adj_out_rb, &dest->adj_out);
 		route_node_set_info(rn, dest);
@@ -727,6 +727,25 @@ subgroup_total_packets_enqueued(struct update_subgroup *subgrp)
 	return pkt->ver - 1;
 }
 
+/*
+ * updgrp_show_packing_stats
+ *
+ * Show how well prefixes were packed into the UPDATEs built so far.
+ */
+static void updgrp_show_packing_stats(struct vty *vty, const char *indent,
+				      uint64_t packets, uint64_t full,
+				      uint64_t prefixes, uint64_t bytes,
+				      uint64_t capacity)
+{
+	vty_out(vty, "%sUPDATE packets built: %" PRIu64 "\n", indent, packets);
+	vty_out(vty, "%sUPDATE packets filled to max size: %" PRIu64 "\n",
+		indent, full);
+	vty_out(vty, "%sPrefixes per UPDATE: %.2f\n", indent,
+		packets ? (double)prefixes / packets : 0.0);
+	vty_out(vty, "%sUPDATE fill ratio: %.1f%%\n", indent,
+		capacity ? (double)bytes * 100 / capacity : 0.0);
+}
+
 static int update_group_show_walkcb(struct update_group *updgrp, void *arg)
 {
 	struct updwalk_context *ctx = arg;
@@ -918,6 +937,17 @@ static int update_group_show_walkcb(struct update_group *updgrp, void *arg)
 			json_object_int_add(json_subgrp_event,
 					    "mergeCheckEvents",
 					    subgrp->merge_checks_triggered);
+			json_object_int_add(json_subgrp_event, "updatePackets",
+					    subgrp->update_packets);
+			json_object_int_add(json_subgrp_event,
+					    "updatePacketsFull",
+					    subgrp->update_packets_full);
+			json_object_int_add(json_subgrp_event, "updatePrefixes",
+					    subgrp->update_prefixes);
+			json_object_int_add(json_subgrp_event, "updateBytes",
+					    subgrp->update_bytes);
+			json_object_int_add(json_subgrp_event, "updateCapacity",
+					    subgrp->update_capacity);
 			json_object_object_add(json_subgrp, "statistics",
 					       json_subgrp_event);
 			json_object_int_add(json_subgrp, "coalesceTime",
@@ -961,6 +991,12 @@ static int update_group_show_walkcb(struct update_group *updgrp, void *arg)
 				subgrp->peer_refreshes_combined);
 			vty_out(vty, "    Merge checks triggered: %u\n",
 				subgrp->merge_checks_triggered);
+			updgrp_show_packing_stats(vty, "    ",
+						  subgrp->update_packets,
+						  subgrp->update_packets_full,
+						  subgrp->update_prefixes,
+						  subgrp->update_bytes,
+						  subgrp->update_capacity);
 			vty_out(vty, "    Coalesce Time: %u%s\n",
 				(UPDGRP_INST(subgrp->update_group))
 					->coalesce_time,
@@ -1575,7 +1611,7 @@ static void update_subgroup_copy_adj_out(struct update_subgroup *source,
 		aout_copy = bgp_adj_out_alloc(dest, aout->dest,
 					      aout->addpath_tx_id);
 		aout_copy->attr =
-			aout->attr ? bgp_attr_intern(aout->attr) : NULL;
+			aout->attr ? bgp_attr_intern_ref(aout->attr) : NULL;
 	}
 
 	dest->scount = source->scount;
@@ -2033,6 +2069,12 @@ void update_group_show_stats(struct bgp *bgp, struct vty *vty)
 		bgp->update_group_stats.peer_refreshes_combined);
 	vty_out(vty, "Merge checks triggered: %u\n",
 		bgp->update_group_stats.merge_checks_triggered);
+	updgrp_show_packing_stats(vty, "",
+				  bgp->update_group_stats.update_packets,
+				  bgp->update_group_stats.update_packets_full,
+				  bgp->update_group_stats.update_prefixes,
+				  bgp->update_group_stats.update_bytes,
+				  bgp->update_group_stats.update_capacity);
 }
 
 /*
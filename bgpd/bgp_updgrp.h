@@ -130,6 +130,12 @@ struct update_group {
 	uint32_t subgrps_created;
 	uint32_t subgrps_deleted;
 
+	uint64_t update_packets;
+	uint64_t update_packets_full;
+	uint64_t update_prefixes;
+	uint64_t update_bytes;
+	uint64_t update_capacity;
+
 	uint32_t num_dbg_en_peers;
 };
 
@@ -195,6 +201,9 @@ struct update_subgroup {
 	/* announcement attribute hash */
 	struct hash *hash;
 
+	/* outbound route-map results, kept while walking the table */
+	struct bgp_rmap_memo *rmap_memo;
+
 	struct event *t_coalesce;
 	uint32_t v_coalesce;
 
@@ -231,6 +240,18 @@ struct update_subgroup {
 	uint32_t split_events;
 	uint32_t merge_checks_triggered;
 
+	/*
+	 * UPDATE packing: packets built, how many of them were closed
+	 * because they ran out of space (rather than out of prefixes
+	 * sharing the attribute set), prefixes packed, bytes encoded and
+	 * the maximum message size available for those packets.
+	 */
+	uint64_t update_packets;
+	uint64_t update_packets_full;
+	uint64_t update_prefixes;
+	uint64_t update_bytes;
+	uint64_t update_capacity;
+
 	uint64_t id;
 
 	uint16_t sflags;
@@ -38,6 +38,7 @@
 #include "bgpd/bgp_nhc.h"
 #include "bgpd/bgp_trace.h"
 
+DEFINE_MPOOL_STATIC(BGP_ADJ_OUT, BGP_ADJ_OUT, sizeof(struct bgp_adj_out));
 
 /********************
  * PRIVATE FUNCTIONS
@@ -88,7 +89,7 @@ static void adj_free(struct bgp_adj_out *adj)
 	RB_REMOVE(bgp_adj_out_rb, &adj->dest->adj_out, adj);
 	bgp_dest_unlock_node(adj->dest);
 
-	XFREE(MTYPE_BGP_ADJ_OUT, adj);
+	XPOOL_FREE(BGP_ADJ_OUT, adj);
 }
 
 static void
@@ -488,7 +489,7 @@ struct bgp_adj_out *bgp_adj_out_alloc(struct update_subgroup *subgrp,
 {
 	struct bgp_adj_out *adj;
 
-	adj = XCALLOC(MTYPE_BGP_ADJ_OUT, sizeof(struct bgp_adj_out));
+	adj = XPOOL_CALLOC(BGP_ADJ_OUT);
 	adj->subgroup = subgrp;
 	adj->addpath_tx_id = addpath_tx_id;
 
@@ -827,6 +828,11 @@ void subgroup_announce_table(struct update_subgroup *subgrp,
 	subgrp->pscount = 0;
 	SET_FLAG(subgrp->sflags, SUBGRP_STATUS_TABLE_REPARSING);
 
+	/* Prefixes sharing attributes will mostly share the outcome of the
+	 * outbound route-map too; see bgp_route_map_apply_memo().
+	 */
+	subgrp->rmap_memo = bgp_rmap_memo_new();
+
 	for (dest = bgp_table_top(table); dest; dest = bgp_route_next(dest)) {
 
 		if (addpath_capable)
@@ -857,6 +863,7 @@ void subgroup_announce_table(struct update_subgroup *subgrp,
 						&ri->tx_addpath));
 		}
 	}
+	bgp_rmap_memo_free(&subgrp->rmap_memo);
 	UNSET_FLAG(subgrp->sflags, SUBGRP_STATUS_TABLE_REPARSING);
 
 	/*
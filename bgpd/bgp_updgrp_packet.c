@@ -331,6 +331,18 @@ void bpacket_queue_show_vty(struct bpacket_queue *q, struct vty *vty)
 	return;
 }
 
+/*
+ * Most peers of a subgroup are sent the packet exactly as it was built,
+ * so the per-peer copy is only made once a nexthop has to be rewritten.
+ */
+static struct stream *bpacket_peer_copy(struct bpacket *pkt,
+					struct stream **s)
+{
+	if (!*s)
+		*s = stream_dup(pkt->buffer);
+	return *s;
+}
+
 struct stream *bpacket_reformat_for_peer(struct bpacket *pkt,
 					 struct peer_af *paf)
 {
@@ -339,19 +351,18 @@ struct stream *bpacket_reformat_for_peer(struct bpacket *pkt,
 	struct peer *peer;
 	struct bgp_filter *filter;
 
-	s = stream_dup(pkt->buffer);
 	peer = PAF_PEER(paf);
 
 	vec = &pkt->arr.entries[BGP_ATTR_VEC_NH];
 
 	if (!CHECK_FLAG(vec->flags, BPKT_ATTRVEC_FLAGS_UPDATED))
-		return s;
+		return stream_share(pkt->buffer);
 
 	uint8_t nhlen;
 	afi_t nhafi;
 	int route_map_sets_nh;
 
-	nhlen = stream_getc_from(s, vec->offset);
+	nhlen = stream_getc_from(pkt->buffer, vec->offset);
 	filter = &peer->filter[paf->afi][paf->safi];
 
 	if (peer_cap_enhe(peer, paf->afi, paf->safi))
@@ -384,11 +395,10 @@ struct stream *bpacket_reformat_for_peer(struct bpacket *pkt,
 				EC_BGP_INVALID_NEXTHOP_LENGTH,
 				"%s: %s: invalid MP nexthop length (AFI IP): %u",
 				__func__, peer->host, nhlen);
-			stream_free(s);
 			return NULL;
 		}
 
-		stream_get_from(&v4nh, s, offset_nh, IPV4_MAX_BYTELEN);
+		stream_get_from(&v4nh, pkt->buffer, offset_nh, IPV4_MAX_BYTELEN);
 		mod_v4nh = &v4nh;
 
 		/*
@@ -434,7 +444,8 @@ struct stream *bpacket_reformat_for_peer(struct bpacket *pkt,
 		}
 
 		if (nh_modified) /* allow for VPN RD */
-			stream_put_in_addr_at(s, offset_nh, mod_v4nh);
+			stream_put_in_addr_at(bpacket_peer_copy(pkt, &s),
+					      offset_nh, mod_v4nh);
 
 		if (bgp_debug_update(peer, NULL, NULL, 0))
 			zlog_debug("u%" PRIu64 ":s%" PRIu64
@@ -490,11 +501,10 @@ struct stream *bpacket_reformat_for_peer(struct bpacket *pkt,
 				EC_BGP_INVALID_NEXTHOP_LENGTH,
 				"%s: %s: invalid MP nexthop length (AFI IP6): %u",
 				__func__, peer->host, nhlen);
-			stream_free(s);
 			return NULL;
 		}
 
-		stream_get_from(&v6nhglobal, s, offset_nhglobal,
+		stream_get_from(&v6nhglobal, pkt->buffer, offset_nhglobal,
 				IPV6_MAX_BYTELEN);
 
 		/*
@@ -541,7 +551,7 @@ struct stream *bpacket_reformat_for_peer(struct bpacket *pkt,
 
 		if (nhlen == BGP_ATTR_NHLEN_IPV6_GLOBAL_AND_LL ||
 		    nhlen == BGP_ATTR_NHLEN_VPNV6_GLOBAL_AND_LL) {
-			stream_get_from(&v6nhlocal, s, offset_nhlocal,
+			stream_get_from(&v6nhlocal, pkt->buffer, offset_nhlocal,
 					IPV6_MAX_BYTELEN);
 			if (IN6_IS_ADDR_UNSPECIFIED(&v6nhlocal)) {
 				mod_v6nhl = &peer->nexthop.v6_local;
@@ -556,12 +566,15 @@ struct stream *bpacket_reformat_for_peer(struct bpacket *pkt,
 		 */
 		if (ll_nexthop_only) {
 			mod_v6nhl = &peer->nexthop.v6_local;
-			stream_put_in6_addr_at(s, offset_nhlocal, mod_v6nhl);
+			stream_put_in6_addr_at(bpacket_peer_copy(pkt, &s),
+					       offset_nhlocal, mod_v6nhl);
 		} else {
 			if (gnh_modified)
-				stream_put_in6_addr_at(s, offset_nhglobal, mod_v6nhg);
+				stream_put_in6_addr_at(bpacket_peer_copy(pkt, &s),
+						       offset_nhglobal, mod_v6nhg);
 			if (lnh_modified)
-				stream_put_in6_addr_at(s, offset_nhlocal, mod_v6nhl);
+				stream_put_in6_addr_at(bpacket_peer_copy(pkt, &s),
+						       offset_nhlocal, mod_v6nhl);
 		}
 
 		if (bgp_debug_update(peer, NULL, NULL, 0)) {
@@ -596,7 +609,7 @@ struct stream *bpacket_reformat_for_peer(struct bpacket *pkt,
 		struct in_addr v4nh, *mod_v4nh;
 		int nh_modified = 0;
 
-		stream_get_from(&v4nh, s, vec->offset + 1, 4);
+		stream_get_from(&v4nh, pkt->buffer, vec->offset + 1, 4);
 		mod_v4nh = &v4nh;
 
 		/* No route-map changes allowed for EVPN nexthops. */
@@ -606,7 +619,8 @@ struct stream *bpacket_reformat_for_peer(struct bpacket *pkt,
 		}
 
 		if (nh_modified)
-			stream_put_in_addr_at(s, vec->offset + 1, mod_v4nh);
+			stream_put_in_addr_at(bpacket_peer_copy(pkt, &s),
+					      vec->offset + 1, mod_v4nh);
 
 		if (bgp_debug_update(peer, NULL, NULL, 0))
 			zlog_debug("u%" PRIu64 ":s%" PRIu64
@@ -615,6 +629,10 @@ struct stream *bpacket_reformat_for_peer(struct bpacket *pkt,
 				   PAF_SUBGRP(paf)->id, peer->host, mod_v4nh);
 	}
 
+	/* nothing to rewrite, hand out a reference to the shared packet */
+	if (!s)
+		s = stream_share(pkt->buffer);
+
 	return s;
 }
 
@@ -687,6 +705,7 @@ struct bpacket *subgroup_update_packet(struct update_subgroup *subgrp)
 	mpls_label_t labels[BGP_MAX_LABELS] = { MPLS_INVALID_LABEL };
 	uint8_t num_labels = 0;
 	struct bgp_ls_nlri *ls_nlri = NULL;
+	bool full = false;
 
 	if (!subgrp)
 		return NULL;
@@ -725,8 +744,10 @@ struct bpacket *subgroup_update_packet(struct update_subgroup *subgrp)
 			+ bgp_packet_mpattr_prefix_size(afi, safi, dest_p);
 
 		/* When remaining space can't include NLRI and it's length.  */
-		if (space_remaining < space_needed)
+		if (space_remaining < space_needed) {
+			full = true;
 			break;
+		}
 
 		/* If packet is empty, set attribute. */
 		if (stream_empty(s)) {
@@ -920,13 +941,14 @@ struct bpacket *subgroup_update_packet(struct update_subgroup *subgrp)
 				   pfx_buf);
 		}
 
-		/* Synchnorize attribute.  */
-		if (adj->attr)
-			bgp_attr_unintern(&adj->attr);
-		else
+		/* Synchnorize attribute.  baa->attr is interned already. */
+		if (!adj->attr) {
 			subgrp->scount++;
-
-		adj->attr = bgp_attr_intern(adv->baa->attr);
+			adj->attr = bgp_attr_intern_ref(adv->baa->attr);
+		} else if (adj->attr != adv->baa->attr) {
+			bgp_attr_unintern(&adj->attr);
+			adj->attr = bgp_attr_intern_ref(adv->baa->attr);
+		}
 		adv = bgp_advertise_clean_subgroup(subgrp, adj);
 	}
 
@@ -953,6 +975,16 @@ struct bpacket *subgroup_update_packet(struct update_subgroup *subgrp)
 				(stream_get_endp(packet)
 				 - stream_get_getp(packet)),
 				peer->max_packet_size, num_pfx);
+
+		SUBGRP_INCR_STAT(subgrp, update_packets);
+		if (full)
+			SUBGRP_INCR_STAT(subgrp, update_packets_full);
+		SUBGRP_INCR_STAT_BY(subgrp, update_prefixes, num_pfx);
+		SUBGRP_INCR_STAT_BY(subgrp, update_bytes,
+				    stream_get_endp(packet));
+		SUBGRP_INCR_STAT_BY(subgrp, update_capacity,
+				    peer->max_packet_size);
+
 		pkt = bpacket_queue_add(SUBGRP_PKTQ(subgrp), packet, &vecarr);
 		stream_reset(s);
 		stream_reset(snlri);
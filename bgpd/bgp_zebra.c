@@ -1264,10 +1264,22 @@ static bool update_ipv6nh_for_route_install(int nh_othervrf, struct bgp *nh_bgp,
 static bool bgp_zebra_use_nhop_weighted(struct bgp *bgp, struct attr *attr,
 					uint64_t *nh_weight)
 {
+	uint64_t link_bw;
+
+	/* Extended communities are exported/imported correctly
+	 * between VRFs, but we need to extract the actual link-bandwidth
+	 * value from the extended communities.
+	 */
+	(void)ecommunity_linkbw_present(bgp_attr_get_ecommunity(attr), &link_bw);
+	/* Fallback to IPv6 address-specific extended community */
+	if (!link_bw)
+		(void)ecommunity_linkbw_present(bgp_attr_get_ipv6_ecommunity(attr),
+						&link_bw);
+
 	/* zero link-bandwidth and link-bandwidth not present are treated
 	 * as the same situation.
 	 */
-	if (!attr->link_bw) {
+	if (!link_bw) {
 		/* the only situations should be if we're either told
 		 * to skip or use default weight.
 		 */
@@ -1275,7 +1287,7 @@ static bool bgp_zebra_use_nhop_weighted(struct bgp *bgp, struct attr *attr,
 			return false;
 		*nh_weight = BGP_ZEBRA_DEFAULT_NHOP_WEIGHT;
 	} else
-		*nh_weight = attr->link_bw;
+		*nh_weight = link_bw;
 
 	return true;
 }
@@ -1346,17 +1358,6 @@ static void bgp_zebra_announce_parse_nexthop(struct bgp_path_info *info, const s
 		 * in some situations.
 		 */
 		if (do_wt_ecmp == BGP_WECMP_BEHAVIOR_LINK_BW) {
-			/* Extended communities are exported/imported correctly
-			 * between VRFs, but we need to extract the actual link-bandwidth
-			 * value from the extended communities.
-			 */
-			(void)ecommunity_linkbw_present(bgp_attr_get_ecommunity(mpinfo->attr),
-							&mpinfo->attr->link_bw);
-			/* Fallback to IPv6 address-specific extended community */
-			if (!mpinfo->attr->link_bw)
-				(void)ecommunity_linkbw_present(bgp_attr_get_ipv6_ecommunity(
-									mpinfo->attr),
-								&mpinfo->attr->link_bw);
 			if (!bgp_zebra_use_nhop_weighted(bgp, mpinfo->attr,
 							 &nh_weight))
 				continue;
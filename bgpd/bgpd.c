@@ -9127,6 +9127,7 @@ void bgp_master_init(struct event_loop *master, const int buffer_size,
 	bm->v_establish_wait = BGP_UPDATE_DELAY_DEFAULT;
 	bm->terminating = false;
 	bm->socket_buffer = buffer_size;
+	bm->io_threads = BGP_IO_THREADS_DEFAULT;
 	bm->wait_for_fib = false;
 	bm->suppress_fib_adv_delay = BGP_DEFAULT_SUPPRESS_FIB_ADV_DELAY;
 	bm->ip_tos = IPTOS_PREC_INTERNETCONTROL;
@@ -9229,33 +9230,52 @@ static const struct cmd_variable_handler bgp_viewvrf_var_handlers[] = {
 	{.completions = NULL},
 };
 
-struct frr_pthread *bgp_pth_io;
+struct frr_pthread *bgp_pth_io[BGP_IO_THREADS_MAX];
 struct frr_pthread *bgp_pth_ka;
 
 static void bgp_pthreads_init(void)
 {
-	assert(!bgp_pth_io);
+	char name[32];
+	char os_name[OS_THREAD_NAMELEN];
+	uint32_t i;
+
+	assert(!bgp_pth_io[0]);
 	assert(!bgp_pth_ka);
+	assert(bm->io_threads >= 1 && bm->io_threads <= BGP_IO_THREADS_MAX);
 
 	struct frr_pthread_attr io = {
-		.start = frr_pthread_attr_default.start,
-		.stop = frr_pthread_attr_default.stop,
+		.start = bgp_io_start,
+		.stop = bgp_io_stop,
 	};
 	struct frr_pthread_attr ka = {
 		.start = bgp_keepalives_start,
 		.stop = bgp_keepalives_stop,
 	};
-	bgp_pth_io = frr_pthread_new(&io, "BGP I/O thread", "bgpd_io");
+
+	for (i = 0; i < bm->io_threads; i++) {
+		if (bm->io_threads == 1) {
+			snprintf(name, sizeof(name), "BGP I/O thread");
+			snprintf(os_name, sizeof(os_name), "bgpd_io");
+		} else {
+			snprintf(name, sizeof(name), "BGP I/O thread %u", i);
+			snprintf(os_name, sizeof(os_name), "bgpd_io%u", i);
+		}
+		bgp_pth_io[i] = frr_pthread_new(&io, name, os_name);
+	}
 	bgp_pth_ka = frr_pthread_new(&ka, "BGP Keepalives thread", "bgpd_ka");
 }
 
 void bgp_pthreads_run(void)
 {
-	frr_pthread_run(bgp_pth_io, NULL);
+	uint32_t i;
+
+	for (i = 0; i < bm->io_threads; i++)
+		frr_pthread_run(bgp_pth_io[i], NULL);
 	frr_pthread_run(bgp_pth_ka, NULL);
 
 	/* Wait until threads are ready. */
-	frr_pthread_wait_running(bgp_pth_io);
+	for (i = 0; i < bm->io_threads; i++)
+		frr_pthread_wait_running(bgp_pth_io[i]);
 	frr_pthread_wait_running(bgp_pth_ka);
 }
 
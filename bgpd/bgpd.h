@@ -115,7 +115,11 @@ enum bgp_af_index {
 #define FOREACH_SAFI(safi)                                            \
 	for (safi = SAFI_UNICAST; safi < SAFI_MAX; safi++)
 
-extern struct frr_pthread *bgp_pth_io;
+/* Pool of I/O pthreads; each peer connection is bound to one of them */
+#define BGP_IO_THREADS_DEFAULT 1
+#define BGP_IO_THREADS_MAX     64
+
+extern struct frr_pthread *bgp_pth_io[BGP_IO_THREADS_MAX];
 extern struct frr_pthread *bgp_pth_ka;
 
 /* FIFO list for peer connections */
@@ -179,6 +183,9 @@ struct bgp_master {
 	/* How big should we set the socket buffer size */
 	uint32_t socket_buffer;
 
+	/* Number of I/O pthreads, fixed at startup */
+	uint32_t io_threads;
+
 	/* Should we do wait for fib install globally? */
 	bool wait_for_fib;
 
@@ -618,6 +625,13 @@ struct bgp {
 		uint32_t updgrps_deleted;
 		uint32_t subgrps_created;
 		uint32_t subgrps_deleted;
+
+		/* UPDATE packing efficiency */
+		uint64_t update_packets;
+		uint64_t update_packets_full;
+		uint64_t update_prefixes;
+		uint64_t update_bytes;
+		uint64_t update_capacity;
 	} update_group_stats;
 
 	struct bgp_snmp_stats *snmp_stats;
@@ -1124,6 +1138,8 @@ struct bgp {
 	struct bgp_damp_config damp[AFI_MAX][SAFI_MAX];
 
 	uint64_t bestpath_runs;
+	uint64_t bestpath_incremental;
+	uint64_t bestpath_full;
 	uint64_t node_already_on_queue;
 	uint64_t node_deferred_on_queue;
 
@@ -509,7 +509,7 @@ static void rfapiBgpInfoFree(struct bgp_path_info *goner)
 
 	if (goner->extra)
 		bgp_path_info_extra_free(&goner->extra);
-	XFREE(MTYPE_BGP_ROUTE, goner);
+	XPOOL_FREE(BGP_ROUTE, goner);
 }
 
 struct rfapi_import_table *rfapiMacImportTableGetNoAlloc(struct bgp *bgp,
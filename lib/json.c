@@ -588,6 +588,27 @@ void frr_json_set_complete(struct json_object *jobj)
 	frr_json_set_data(jobj, frrflags);
 }
 
+void frr_json_vty_flush(struct vty *vty, struct json_object *jobj)
+{
+	int frrflags;
+	size_t pending;
+
+	frrflags = frr_json_get_flags(jobj);
+	if (!CHECK_FLAG(frrflags, FRR_JSON_OPEN))
+		return;
+
+	if (json_object_get_type(jobj) == json_type_array)
+		pending = json_object_array_length(jobj);
+	else
+		pending = json_object_object_length(jobj);
+
+	/* Nothing new since the last flush, don't emit an empty line */
+	if (!pending && CHECK_FLAG(frrflags, FRR_JSON_STARTED))
+		return;
+
+	frr_json_obj_to_vty(vty, jobj, NULL, 0, JSON_C_TO_STRING_NOSLASHESCAPE);
+}
+
 #else /* Older libjson-c version, no incremental support */
 
 #define FRR_OPEN_STR  "frr"
@@ -660,4 +681,9 @@ void frr_json_set_complete(struct json_object *jobj)
 	json_object_set_serializer(jobj, NULL, str, frr_jobj_del_func);
 }
 
+void frr_json_vty_flush(struct vty *vty, struct json_object *jobj)
+{
+	/* Open objects are only written out once complete */
+}
+
 #endif /* libjson-c version dependencies */
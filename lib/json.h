@@ -164,6 +164,14 @@ void frr_json_set_open(struct json_object *jobj);
  */
 void frr_json_set_complete(struct json_object *jobj);
 
+/*
+ * If 'jobj' is held open, write out (without pretty-printing) the children
+ * added since the last call and drop them, so that a large collection can
+ * be streamed to the vty with only the pending children in memory.  Does
+ * nothing for objects that are not open.
+ */
+void frr_json_vty_flush(struct vty *vty, struct json_object *jobj);
+
 #ifdef __cplusplus
 }
 #endif
@@ -33,7 +33,8 @@ DEFINE_MTYPE(LIB, TMP, "Temporary memory");
 DEFINE_MTYPE(LIB, TMP_TTABLE, "Temporary memory for TTABLE");
 DEFINE_MTYPE(LIB, BITFIELD, "Bitfield memory");
 
-static inline void mt_count_alloc(struct memtype *mt, size_t size, void *ptr)
+static inline void mt_count_alloc_size(struct memtype *mt, size_t size,
+				       size_t allocsz)
 {
 	size_t current;
 	size_t oldsize;
@@ -58,10 +59,8 @@ static inline void mt_count_alloc(struct memtype *mt, size_t size, void *ptr)
 				      memory_order_relaxed);
 
 #ifdef HAVE_MALLOC_USABLE_SIZE
-	size_t mallocsz = malloc_usable_size(ptr);
-
-	current = mallocsz + atomic_fetch_add_explicit(&mt->total, mallocsz,
-						       memory_order_relaxed);
+	current = allocsz + atomic_fetch_add_explicit(&mt->total, allocsz,
+						      memory_order_relaxed);
 	oldsize = atomic_load_explicit(&mt->max_size, memory_order_relaxed);
 	if (current > oldsize)
 		/* note that this may fail, but approximation is sufficient */
@@ -72,7 +71,8 @@ static inline void mt_count_alloc(struct memtype *mt, size_t size, void *ptr)
 #endif
 }
 
-static inline void mt_count_free(struct memtype *mt, void *ptr)
+static inline void mt_count_free_size(struct memtype *mt, void *ptr,
+				      size_t allocsz)
 {
 	frrtrace(2, frr_libfrr, memfree, mt, ptr);
 
@@ -80,10 +80,24 @@ static inline void mt_count_free(struct memtype *mt, void *ptr)
 	atomic_fetch_sub_explicit(&mt->n_alloc, 1, memory_order_relaxed);
 
 #ifdef HAVE_MALLOC_USABLE_SIZE
-	size_t mallocsz = malloc_usable_size(ptr);
+	atomic_fetch_sub_explicit(&mt->total, allocsz, memory_order_relaxed);
+#endif
+}
 
-	atomic_fetch_sub_explicit(&mt->total, mallocsz, memory_order_relaxed);
+#ifdef HAVE_MALLOC_USABLE_SIZE
+#define mt_usable_size(ptr) malloc_usable_size(ptr)
+#else
+#define mt_usable_size(ptr) 0
 #endif
+
+static inline void mt_count_alloc(struct memtype *mt, size_t size, void *ptr)
+{
+	mt_count_alloc_size(mt, size, mt_usable_size(ptr));
+}
+
+static inline void mt_count_free(struct memtype *mt, void *ptr)
+{
+	mt_count_free_size(mt, ptr, mt_usable_size(ptr));
 }
 
 static inline void *mt_checkalloc(struct memtype *mt, void *ptr, size_t size)
@@ -136,6 +150,169 @@ void qfree(struct memtype *mt, void *ptr)
 	free(ptr);
 }
 
+/*
+ * Object pools.
+ *
+ * Each slab is MPOOL_SLAB_SIZE bytes, aligned to its own size, so the slab
+ * an object belongs to is found by masking the object's address.  Objects
+ * are handed out from the slab's free list first and otherwise carved off
+ * the never-used tail of the slab, so a fresh slab doesn't get touched (and
+ * paged in) all at once.  Full slabs are not on any list; slabs with free
+ * objects are on pool->partial.
+ */
+#define MPOOL_SLAB_SIZE (64 * 1024)
+#define MPOOL_ALIGN	16
+
+struct mpool_slab {
+	struct mpool_slab *next, *prev;
+	struct mpool *pool;
+
+	void *freelist;
+	char *fresh;
+	char *end;
+
+	unsigned int used;
+	unsigned int total;
+};
+
+#define MPOOL_SLAB_HDR                                                         \
+	((sizeof(struct mpool_slab) + MPOOL_ALIGN - 1) & ~(MPOOL_ALIGN - 1))
+
+static inline size_t mpool_stride(const struct mpool *mp)
+{
+	size_t stride = (mp->objsize + MPOOL_ALIGN - 1) & ~(MPOOL_ALIGN - 1);
+
+	return MAX(stride, sizeof(void *));
+}
+
+static inline struct mpool_slab *mpool_slab_of(void *ptr)
+{
+	return (struct mpool_slab *)((uintptr_t)ptr &
+				     ~(uintptr_t)(MPOOL_SLAB_SIZE - 1));
+}
+
+static void mpool_slab_link(struct mpool *mp, struct mpool_slab *slab)
+{
+	slab->prev = NULL;
+	slab->next = mp->partial;
+	if (mp->partial)
+		mp->partial->prev = slab;
+	mp->partial = slab;
+}
+
+static void mpool_slab_unlink(struct mpool *mp, struct mpool_slab *slab)
+{
+	if (slab->prev)
+		slab->prev->next = slab->next;
+	else
+		mp->partial = slab->next;
+	if (slab->next)
+		slab->next->prev = slab->prev;
+	slab->next = slab->prev = NULL;
+}
+
+static void mpool_slab_reset(struct mpool *mp, struct mpool_slab *slab)
+{
+	size_t stride = mpool_stride(mp);
+
+	slab->pool = mp;
+	slab->freelist = NULL;
+	slab->fresh = (char *)slab + MPOOL_SLAB_HDR;
+	slab->total = (MPOOL_SLAB_SIZE - MPOOL_SLAB_HDR) / stride;
+	slab->end = slab->fresh + (size_t)slab->total * stride;
+	slab->used = 0;
+}
+
+static struct mpool_slab *mpool_slab_new(struct mpool *mp)
+{
+	struct mpool_slab *slab;
+	void *mem;
+
+	/* pools are meant for small objects */
+	assert(mpool_stride(mp) * 8 <= MPOOL_SLAB_SIZE - MPOOL_SLAB_HDR);
+
+	if (posix_memalign(&mem, MPOOL_SLAB_SIZE, MPOOL_SLAB_SIZE))
+		memory_oom(MPOOL_SLAB_SIZE, mp->mt->name);
+
+	slab = mem;
+	mpool_slab_reset(mp, slab);
+	return slab;
+}
+
+void *mpool_calloc(struct mpool *mp)
+{
+	struct mpool_slab *slab;
+	void *ptr;
+
+	pthread_mutex_lock(&mp->mtx);
+
+	slab = mp->partial;
+	if (!slab) {
+		if (mp->spare) {
+			slab = mp->spare;
+			mp->spare = NULL;
+		} else
+			slab = mpool_slab_new(mp);
+		mpool_slab_link(mp, slab);
+	}
+
+	if (slab->freelist) {
+		ptr = slab->freelist;
+		slab->freelist = *(void **)ptr;
+	} else {
+		assert(slab->fresh < slab->end);
+		ptr = slab->fresh;
+		slab->fresh += mpool_stride(mp);
+	}
+
+	if (++slab->used == slab->total)
+		mpool_slab_unlink(mp, slab);
+
+	pthread_mutex_unlock(&mp->mtx);
+
+	memset(ptr, 0, mp->objsize);
+
+	frrtrace(3, frr_libfrr, memalloc, mp->mt, ptr, mp->objsize);
+	mt_count_alloc_size(mp->mt, mp->objsize, mpool_stride(mp));
+	return ptr;
+}
+
+void mpool_free(struct mpool *mp, void *ptr)
+{
+	struct mpool_slab *slab, *drop = NULL;
+
+	if (!ptr)
+		return;
+
+	slab = mpool_slab_of(ptr);
+	assert(slab->pool == mp);
+
+	mt_count_free_size(mp->mt, ptr, mpool_stride(mp));
+
+	pthread_mutex_lock(&mp->mtx);
+
+	if (slab->used == slab->total)
+		mpool_slab_link(mp, slab);
+
+	*(void **)ptr = slab->freelist;
+	slab->freelist = ptr;
+
+	if (--slab->used == 0) {
+		mpool_slab_unlink(mp, slab);
+
+		/* keep one empty slab, give the others back */
+		if (!mp->spare) {
+			mpool_slab_reset(mp, slab);
+			mp->spare = slab;
+		} else
+			drop = slab;
+	}
+
+	pthread_mutex_unlock(&mp->mtx);
+
+	free(drop);
+}
+
 int qmem_walk(qmem_walk_fn *func, void *arg)
 {
 	struct memgroup *mg;
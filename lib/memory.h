@@ -9,6 +9,7 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <pthread.h>
 #include <frratomic.h>
 #include "compiler.h"
 
@@ -161,6 +162,68 @@ extern void qfree(struct memtype *mt, void *ptr) __attribute__((nonnull(1)));
 		ptr = NULL;                                                    \
 	} while (0)
 
+/*
+ * Pools for small fixed-size objects that are allocated in large numbers.
+ *
+ * Objects are carved out of 64KiB slabs rather than malloc'd one by one,
+ * which avoids per-object malloc overhead and fragmentation, and keeps
+ * objects allocated together close in memory.  Slabs that become empty
+ * are released again.  Allocations are accounted against the pool's MTYPE
+ * like regular ones, so "show memory" and leak reporting work unchanged.
+ *
+ *  mydaemon.c
+ *    DEFINE_MPOOL_STATIC(MYDAEMON_FOO, MYDAEMON_FOO, sizeof(struct foo));
+ *    foo = XPOOL_CALLOC(MYDAEMON_FOO);
+ *    XPOOL_FREE(MYDAEMON_FOO, foo);
+ *
+ * Pool objects must only be released with XPOOL_FREE on the same pool.
+ */
+struct mpool_slab;
+
+struct mpool {
+	struct memtype *mt;
+	size_t objsize;
+
+	pthread_mutex_t mtx;
+	struct mpool_slab *partial;
+	struct mpool_slab *spare;
+};
+
+/* clang-format off */
+
+#define DECLARE_MPOOL(name)                                                    \
+	extern struct mpool MPOOL_##name[1]                                    \
+	/* end */
+
+#define DEFINE_MPOOL_ATTR(pname, attr, mtype, size)                            \
+	attr struct mpool MPOOL_##pname[1] = { {                               \
+		.mt = MTYPE_##mtype,                                           \
+		.objsize = (size),                                             \
+		.mtx = PTHREAD_MUTEX_INITIALIZER,                              \
+	} }                                                                    \
+	/* end */
+
+#define DEFINE_MPOOL(pname, mtype, size)                                       \
+	DEFINE_MPOOL_ATTR(pname, , mtype, size)                                \
+	/* end */
+
+#define DEFINE_MPOOL_STATIC(pname, mtype, size)                                \
+	DEFINE_MPOOL_ATTR(pname, static, mtype, size)                          \
+	/* end */
+
+/* clang-format on */
+
+extern void *mpool_calloc(struct mpool *mp)
+	__attribute__((malloc, nonnull(1) _RET_NONNULL));
+extern void mpool_free(struct mpool *mp, void *ptr) __attribute__((nonnull(1)));
+
+#define XPOOL_CALLOC(pool)		mpool_calloc(MPOOL_##pool)
+#define XPOOL_FREE(pool, ptr)                                                  \
+	do {                                                                   \
+		mpool_free(MPOOL_##pool, ptr);                                 \
+		ptr = NULL;                                                    \
+	} while (0)
+
 static inline size_t mtype_stats_alloc(struct memtype *mt)
 {
 	return mt->n_alloc;
@@ -23,6 +23,7 @@
 
 DEFINE_MTYPE_STATIC(LIB, STREAM, "Stream");
 DEFINE_MTYPE_STATIC(LIB, STREAM_FIFO, "Stream FIFO");
+DEFINE_MTYPE_STATIC(LIB, STREAM_REFCNT, "Stream shared data refcount");
 
 /* Tests whether a position is valid */
 #define GETP_VALID(S, G) ((G) <= (S)->endp)
@@ -104,6 +105,7 @@ struct stream *stream_new(size_t size)
 	s->next = NULL;
 	s->size = size;
 	s->allow_expansion = false;
+	s->refcnt = NULL;
 	return s;
 }
 
@@ -120,6 +122,16 @@ void stream_free(struct stream *s)
 	if (!s)
 		return;
 
+	if (s->refcnt) {
+		/* other streams still reference the data segment */
+		if (atomic_fetch_sub_explicit(s->refcnt, 1,
+					      memory_order_acq_rel) > 1) {
+			XFREE(MTYPE_STREAM, s);
+			return;
+		}
+		XFREE(MTYPE_STREAM_REFCNT, s->refcnt);
+	}
+
 	XFREE(MTYPE_STREAM, s->data);
 	XFREE(MTYPE_STREAM, s);
 }
@@ -150,6 +162,33 @@ struct stream *stream_dup(const struct stream *s)
 	return (stream_copy(snew, s));
 }
 
+struct stream *stream_share(struct stream *s)
+{
+	struct stream *snew;
+
+	STREAM_VERIFY_SANE(s);
+
+	/*
+	 * The first reference is set up on the owner, which is expected to
+	 * happen before 's' is handed to another pthread.
+	 */
+	if (!s->refcnt) {
+		s->refcnt = XMALLOC(MTYPE_STREAM_REFCNT, sizeof(*s->refcnt));
+		atomic_store_explicit(s->refcnt, 1, memory_order_relaxed);
+	}
+	atomic_fetch_add_explicit(s->refcnt, 1, memory_order_relaxed);
+
+	snew = XMALLOC(MTYPE_STREAM, sizeof(struct stream));
+	snew->next = NULL;
+	snew->getp = s->getp;
+	snew->endp = s->endp;
+	snew->size = s->size;
+	snew->allow_expansion = false;
+	snew->data = s->data;
+	snew->refcnt = s->refcnt;
+	return snew;
+}
+
 struct stream *stream_dupcat(const struct stream *s1, const struct stream *s2,
 			     size_t offset)
 {
@@ -181,6 +220,7 @@ size_t stream_resize_inplace(struct stream **sptr, size_t newsize)
 	struct stream *orig = *sptr;
 
 	STREAM_VERIFY_SANE(orig);
+	assert(!orig->refcnt);
 
 	orig->data = XREALLOC(MTYPE_STREAM, orig->data, newsize);
 
@@ -211,6 +251,8 @@ static void stream_expand(struct stream *s, size_t expand_size)
 		actual_expand_size = MIN_STREAM_EXPANSION_SZ;
 	}
 
+	assert(!s->refcnt);
+
 	/* Calculate new total size */
 	new_size = s->size + actual_expand_size;
 	/* Reallocate the data buffer */
@@ -97,6 +97,13 @@ struct stream {
 	size_t size;	       /* size of data segment */
 	bool allow_expansion;  /* whether stream can be expanded */
 	unsigned char *data;   /* data pointer */
+
+	/*
+	 * Reference count on the data segment when it is shared with other
+	 * streams through stream_share(), NULL if this stream owns it alone.
+	 * Shared data is read-only: only getp may be moved on such a stream.
+	 */
+	atomic_uint *refcnt;
 };
 
 /* First in first out queue structure. */
@@ -140,6 +147,14 @@ extern struct stream *stream_copy(struct stream *dest,
 				  const struct stream *src);
 extern struct stream *stream_dup(const struct stream *s);
 
+/*
+ * Return a new stream referencing the data segment of 's' without copying
+ * it.  Both streams may be freed independently (and from different
+ * pthreads); the data is released together with the last reference.
+ * Neither stream may be written to afterwards.
+ */
+extern struct stream *stream_share(struct stream *s);
+
 extern size_t stream_resize_inplace(struct stream **sptr, size_t newsize);
 
 extern size_t stream_get_getp(const struct stream *s);
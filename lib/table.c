@@ -210,6 +210,47 @@ static void route_common(const struct prefix *n, const struct prefix *p,
 	}
 }
 
+/*
+ * prefix_match() for the tree walks below.  IPv4 and IPv6 compare a word
+ * at a time instead of a byte at a time, since this runs for every node
+ * visited on the way down the tree in route_node_match()/route_node_get().
+ */
+static inline bool route_node_prefix_match(const struct prefix *n,
+					   const struct prefix *p)
+{
+	uint32_t nw, pw, mask;
+	unsigned int i, bits;
+
+	if (n->prefixlen > p->prefixlen)
+		return false;
+
+	if (n->family == AF_INET) {
+		if (n->prefixlen == 0)
+			return true;
+
+		mask = htonl(0xffffffffU << (IPV4_MAX_BITLEN - n->prefixlen));
+		return !((n->u.prefix4.s_addr ^ p->u.prefix4.s_addr) & mask);
+	}
+
+	if (n->family == AF_INET6) {
+		for (i = 0; i < IPV6_MAX_BYTELEN; i += 4) {
+			if (n->prefixlen <= i * 8)
+				break;
+			bits = n->prefixlen - i * 8;
+
+			memcpy(&nw, &n->u.prefix6.s6_addr[i], sizeof(nw));
+			memcpy(&pw, &p->u.prefix6.s6_addr[i], sizeof(pw));
+			mask = bits >= 32 ? 0xffffffffU
+					  : htonl(0xffffffffU << (32 - bits));
+			if ((nw ^ pw) & mask)
+				return false;
+		}
+		return true;
+	}
+
+	return prefix_match(n, p);
+}
+
 static void set_link(struct route_node *node, struct route_node *new)
 {
 	unsigned int bit = prefix_bit(&new->p.u.prefix, node->p.prefixlen);
@@ -246,7 +287,7 @@ struct route_node *route_node_match(struct route_table *table,
 	/* Walk down tree.  If there is matched route then store it to
 	   matched. */
 	while (node && node->p.prefixlen <= p->prefixlen
-	       && prefix_match(&node->p, p)) {
+	       && route_node_prefix_match(&node->p, p)) {
 		if (node->info)
 			matched = node;
 
@@ -334,7 +375,7 @@ struct route_node *route_node_get(struct route_table *table,
 	match = NULL;
 	node = table->top;
 	while (node && node->p.prefixlen <= prefixlen
-	       && prefix_match(&node->p, p)) {
+	       && route_node_prefix_match(&node->p, p)) {
 		if (node->p.prefixlen == prefixlen) {
 			if (p->family == AF_FLOWSPEC)
 				prefix_flowspec_ptr_free(p);
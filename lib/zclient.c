@@ -1818,6 +1818,59 @@ stream_failure:
 	return -1;
 }
 
+/*
+ * ZEBRA_ROUTE_ADD_BATCH is a regular route add for the first prefix,
+ * started with zapi_route_encode(), followed by any number of further
+ * prefixes of the same family that share everything else with it. Each of
+ * those is encoded as just its length and significant bytes.
+ *
+ * Appends one such prefix and updates the message length. Returns -1,
+ * leaving the stream untouched, if it doesn't fit.
+ */
+int zapi_route_batch_add(struct stream *s, const struct prefix *p)
+{
+	int psize = PSIZE(p->prefixlen);
+
+	if (STREAM_WRITEABLE(s) < (size_t)(1 + psize))
+		return -1;
+
+	stream_putc(s, p->prefixlen);
+	stream_write(s, &p->u.prefix, psize);
+
+	stream_putw_at(s, 0, stream_get_endp(s));
+
+	return 0;
+}
+
+/*
+ * Replaces api->prefix with the next prefix of a ZEBRA_ROUTE_ADD_BATCH
+ * message, once zapi_route_decode() has consumed the first one. Returns 1
+ * if there was one, 0 at the end of the message and -1 on error.
+ */
+int zapi_route_batch_decode_prefix(struct stream *s, struct zapi_route *api)
+{
+	uint8_t prefixlen;
+
+	if (STREAM_READABLE(s) == 0)
+		return 0;
+
+	STREAM_GETC(s, prefixlen);
+	if (prefixlen > prefix_blen(&api->prefix) * 8) {
+		flog_err(EC_LIB_ZAPI_MISSMATCH,
+			 "%s: batch prefixlen %u is too large for family %d",
+			 __func__, prefixlen, api->prefix.family);
+		return -1;
+	}
+
+	api->prefix.prefixlen = prefixlen;
+	memset(&api->prefix.u.prefix, 0, prefix_blen(&api->prefix));
+	STREAM_GET(&api->prefix.u.prefix, s, PSIZE(prefixlen));
+
+	return 1;
+stream_failure:
+	return -1;
+}
+
 static void zapi_encode_prefix(struct stream *s, struct prefix *p,
 			       uint8_t family)
 {
@@ -238,6 +238,7 @@ typedef enum {
 	ZEBRA_TC_FILTER_DELETE,
 	ZEBRA_OPAQUE_NOTIFY,
 	ZEBRA_SRV6_SID_NOTIFY,
+	ZEBRA_ROUTE_ADD_BATCH,
 } zebra_message_types_t;
 /* Zebra message types. Please update the corresponding
  * command_types array with any changes!
@@ -1185,6 +1186,9 @@ void zapi_nexthop_init(struct zapi_nexthop *znh);
 
 extern int zapi_route_encode(uint8_t cmd, struct stream *s, struct zapi_route *api);
 extern int zapi_route_decode(struct stream *s, struct zapi_route *api);
+extern int zapi_route_batch_add(struct stream *s, const struct prefix *p);
+extern int zapi_route_batch_decode_prefix(struct stream *s,
+					  struct zapi_route *api);
 extern int zapi_nexthop_decode(struct stream *s, struct zapi_nexthop *api_nh,
 			       uint32_t api_flags, uint32_t api_message);
 bool zapi_nhg_notify_decode(struct stream *s, uint32_t *id,
@@ -34,6 +34,9 @@ struct sharp_routes {
 	uint32_t tableid;
 	bool stop_loop;
 
+	/* Send routes in ZEBRA_ROUTE_ADD_BATCH messages */
+	bool batch;
+
 	uint8_t inst;
 	vrf_id_t vrf_id;
 
@@ -217,7 +217,7 @@ DEFPY (install_routes,
 	  <nexthop <A.B.C.D$nexthop4|X:X::X:X$nexthop6>|\
 	   nexthop-group NHGNAME$nexthop_group>\
 	  [backup$backup <A.B.C.D$backup_nexthop4|X:X::X:X$backup_nexthop6>] \
-	  (1-1000000)$routes [instance (0-255)$instance] [table (0-4294967295)$table_id] [repeat (2-1000)$rpt] [opaque WORD] [no-recurse$norecurse]",
+	  (1-1000000)$routes [instance (0-255)$instance] [table (0-4294967295)$table_id] [repeat (2-1000)$rpt] [opaque WORD] [no-recurse$norecurse] [batch$batch]",
        "Sharp routing Protocol\n"
        "install some routes\n"
        "Routes to install\n"
@@ -242,7 +242,8 @@ DEFPY (install_routes,
        "How many times to repeat this command\n"
        "What opaque data to send down\n"
        "The opaque data\n"
-       "No recursive nexthops\n")
+       "No recursive nexthops\n"
+       "Send the routes to zebra in batched messages\n")
 {
 	struct vrf *vrf;
 	struct prefix prefix;
@@ -255,6 +256,7 @@ DEFPY (install_routes,
 	sg.r.tableid = 0;
 	sg.r.tableid_set = false;
 	sg.r.stop_loop = false;
+	sg.r.batch = !!batch;
 
 	if (rpt >= 2)
 		sg.r.repeat = rpt * 2;
@@ -409,6 +411,7 @@ DEFPY (install_seg6_routes,
 	sg.r.total_routes = routes;
 	sg.r.installed_routes = 0;
 	sg.r.stop_loop = false;
+	sg.r.batch = false;
 
 	if (rpt >= 2)
 		sg.r.repeat = rpt * 2;
@@ -503,6 +506,7 @@ DEFPY(install_seg6local_segs_routes, install_seg6local_segs_routes_cmd,
 	sg.r.total_routes = routes;
 	sg.r.installed_routes = 0;
 	sg.r.stop_loop = false;
+	sg.r.batch = false;
 
 	if (rpt >= 2)
 		sg.r.repeat = rpt * 2;
@@ -639,6 +643,7 @@ DEFPY (install_seg6local_routes,
 	sg.r.total_routes = routes;
 	sg.r.installed_routes = 0;
 	sg.r.stop_loop = false;
+	sg.r.batch = false;
 
 	if (rpt >= 2)
 		sg.r.repeat = rpt * 2;
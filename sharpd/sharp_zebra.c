@@ -227,79 +227,92 @@ struct buffer_delay {
 } wb;
 
 /*
- * route_add - Encodes a route to zebra
- *
- * This function returns true when the route was buffered
- * by the underlying stream system
+ * route_add_api - Fills in the zapi route for installing 'p'
  */
-static bool route_add(const struct prefix *p, vrf_id_t vrf_id, uint8_t instance, uint32_t nhgid,
-		      const struct nexthop_group *nhg, const struct nexthop_group *backup_nhg,
-		      uint32_t flags, char *opaque, uint32_t tableid, bool tableid_set)
+static void route_add_api(struct zapi_route *api, const struct prefix *p, vrf_id_t vrf_id,
+			  uint8_t instance, uint32_t nhgid, const struct nexthop_group *nhg,
+			  const struct nexthop_group *backup_nhg, uint32_t flags, char *opaque,
+			  uint32_t tableid, bool tableid_set)
 {
-	struct zapi_route api;
 	struct zapi_nexthop *api_nh;
 	struct nexthop *nh;
 	int i = 0;
 
-	zapi_route_init(&api);
-	api.vrf_id = vrf_id;
-	api.type = ZEBRA_ROUTE_SHARP;
-	api.instance = instance;
-	api.safi = SAFI_UNICAST;
-	memcpy(&api.prefix, p, sizeof(*p));
+	zapi_route_init(api);
+	api->vrf_id = vrf_id;
+	api->type = ZEBRA_ROUTE_SHARP;
+	api->instance = instance;
+	api->safi = SAFI_UNICAST;
+	memcpy(&api->prefix, p, sizeof(*p));
 
-	api.flags = flags;
+	api->flags = flags;
 
 	if (sg.use_underlying_nexthop_group_weight)
-		SET_FLAG(api.flags, ZEBRA_FLAG_USE_RECURSIVE_WEIGHT);
+		SET_FLAG(api->flags, ZEBRA_FLAG_USE_RECURSIVE_WEIGHT);
 
 	if (tableid_set) {
-		api.tableid = tableid;
-		SET_FLAG(api.message, ZAPI_MESSAGE_TABLEID);
+		api->tableid = tableid;
+		SET_FLAG(api->message, ZAPI_MESSAGE_TABLEID);
 	}
 
 	/* Only send via ID if nhgroup has been successfully installed */
 	if (nhgid && sharp_nhgroup_id_is_installed(nhgid)) {
-		zapi_route_set_nhg_id(&api, &nhgid);
+		zapi_route_set_nhg_id(api, &nhgid);
 	} else {
-		SET_FLAG(api.message, ZAPI_MESSAGE_NEXTHOP);
+		SET_FLAG(api->message, ZAPI_MESSAGE_NEXTHOP);
 		for (ALL_NEXTHOPS_PTR(nhg, nh)) {
 			/* Check if we set a VNI label */
 			if (nh->nh_label &&
 			    (nh->nh_label_type == ZEBRA_LSP_EVPN))
-				SET_FLAG(api.flags, ZEBRA_FLAG_EVPN_ROUTE);
+				SET_FLAG(api->flags, ZEBRA_FLAG_EVPN_ROUTE);
 
-			api_nh = &api.nexthops[i];
+			api_nh = &api->nexthops[i];
 
 			zapi_nexthop_from_nexthop(api_nh, nh);
 
 			i++;
 		}
-		api.nexthop_num = i;
+		api->nexthop_num = i;
 	}
 
 	/* Include backup nexthops, if present */
 	if (backup_nhg && backup_nhg->nexthop) {
-		SET_FLAG(api.message, ZAPI_MESSAGE_BACKUP_NEXTHOPS);
+		SET_FLAG(api->message, ZAPI_MESSAGE_BACKUP_NEXTHOPS);
 
 		i = 0;
 		for (ALL_NEXTHOPS_PTR(backup_nhg, nh)) {
-			api_nh = &api.backup_nexthops[i];
+			api_nh = &api->backup_nexthops[i];
 
 			zapi_backup_nexthop_from_nexthop(api_nh, nh);
 
 			i++;
 		}
 
-		api.backup_nexthop_num = i;
+		api->backup_nexthop_num = i;
 	}
 
 	if (strlen(opaque)) {
-		SET_FLAG(api.message, ZAPI_MESSAGE_OPAQUE);
-		api.opaque.length = strlen(opaque) + 1;
-		assert(api.opaque.length <= ZAPI_MESSAGE_OPAQUE_LENGTH);
-		memcpy(api.opaque.data, opaque, api.opaque.length);
+		SET_FLAG(api->message, ZAPI_MESSAGE_OPAQUE);
+		api->opaque.length = strlen(opaque) + 1;
+		assert(api->opaque.length <= ZAPI_MESSAGE_OPAQUE_LENGTH);
+		memcpy(api->opaque.data, opaque, api->opaque.length);
 	}
+}
+
+/*
+ * route_add - Encodes a route to zebra
+ *
+ * This function returns true when the route was buffered
+ * by the underlying stream system
+ */
+static bool route_add(const struct prefix *p, vrf_id_t vrf_id, uint8_t instance, uint32_t nhgid,
+		      const struct nexthop_group *nhg, const struct nexthop_group *backup_nhg,
+		      uint32_t flags, char *opaque, uint32_t tableid, bool tableid_set)
+{
+	struct zapi_route api;
+
+	route_add_api(&api, p, vrf_id, instance, nhgid, nhg, backup_nhg, flags, opaque, tableid,
+		      tableid_set);
 
 	if (zclient_route_send(ZEBRA_ROUTE_ADD, g_zclient, &api) ==
 	    ZCLIENT_SEND_BUFFERED)
@@ -308,6 +321,50 @@ static bool route_add(const struct prefix *p, vrf_id_t vrf_id, uint8_t instance,
 		return false;
 }
 
+/*
+ * route_add_batch - Encodes up to 'routes' consecutive routes starting
+ * at 'p' to zebra in one ZEBRA_ROUTE_ADD_BATCH message
+ *
+ * On return 'p' is the next prefix to install and 'routes' the number
+ * of routes that went into the message. This function returns true when
+ * the message was buffered by the underlying stream system
+ */
+static bool route_add_batch(struct prefix *p, uint32_t *routes, vrf_id_t vrf_id,
+			    uint8_t instance, uint32_t nhgid, const struct nexthop_group *nhg,
+			    const struct nexthop_group *backup_nhg, uint32_t flags, char *opaque,
+			    uint32_t tableid, bool tableid_set)
+{
+	struct zapi_route api;
+	uint32_t temp, i = 0;
+	bool v4 = (p->family == AF_INET);
+	int ret;
+
+	route_add_api(&api, p, vrf_id, instance, nhgid, nhg, backup_nhg, flags, opaque, tableid,
+		      tableid_set);
+
+	ret = zapi_route_encode(ZEBRA_ROUTE_ADD_BATCH, g_zclient->obuf, &api);
+
+	if (v4)
+		temp = ntohl(p->u.prefix4.s_addr);
+	else
+		temp = ntohl(p->u.val32[3]);
+
+	do {
+		if (v4)
+			p->u.prefix4.s_addr = htonl(++temp);
+		else
+			p->u.val32[3] = htonl(++temp);
+		i++;
+	} while (ret == 0 && i < *routes && zapi_route_batch_add(g_zclient->obuf, p) == 0);
+
+	*routes = i;
+
+	if (ret == 0 && zclient_send_message(g_zclient) == ZCLIENT_SEND_BUFFERED)
+		return true;
+	else
+		return false;
+}
+
 /*
  * route_delete - Encodes a route for deletion to zebra
  *
@@ -345,8 +402,9 @@ static void sharp_install_routes_restart(struct prefix *p, uint32_t count, vrf_i
 					 uint32_t flags, char *opaque, uint32_t tableid,
 					 bool tableid_set)
 {
-	uint32_t temp, i;
+	uint32_t temp, i, sent;
 	bool v4 = false;
+	bool buffered;
 
 	if (p->family == AF_INET) {
 		v4 = true;
@@ -355,12 +413,19 @@ static void sharp_install_routes_restart(struct prefix *p, uint32_t count, vrf_i
 		temp = ntohl(p->u.val32[3]);
 
 	for (i = count; i < routes; i++) {
-		bool buffered = route_add(p, vrf_id, (uint8_t)instance, nhgid, nhg, backup_nhg,
-					  flags, opaque, tableid, tableid_set);
-		if (v4)
-			p->u.prefix4.s_addr = htonl(++temp);
-		else
-			p->u.val32[3] = htonl(++temp);
+		if (sg.r.batch) {
+			sent = routes - i;
+			buffered = route_add_batch(p, &sent, vrf_id, (uint8_t)instance, nhgid, nhg,
+						   backup_nhg, flags, opaque, tableid, tableid_set);
+			i += sent - 1;
+		} else {
+			buffered = route_add(p, vrf_id, (uint8_t)instance, nhgid, nhg, backup_nhg,
+					     flags, opaque, tableid, tableid_set);
+			if (v4)
+				p->u.prefix4.s_addr = htonl(++temp);
+			else
+				p->u.val32[3] = htonl(++temp);
+		}
 
 		if (buffered) {
 			wb.p = *p;
@@ -1017,7 +1017,7 @@ static int validate(struct aspath *as, const struct test_spec *sp)
 	int fails = 0;
 	const uint8_t *out;
 	static struct stream *s;
-	struct aspath *asinout, *asconfeddel, *asstr, *as4;
+	struct aspath *asinout, *asconfeddel, *asstr, *as4, *asdup;
 
 	if (as == NULL && sp->shouldbe == NULL) {
 		printf("Correctly failed to parse\n");
@@ -1128,6 +1128,24 @@ static int validate(struct aspath *as, const struct test_spec *sp)
 		printf("private check: %d %d\n", sp->private_as,
 		       aspath_private_as_check(as));
 	}
+
+	/* an interned path answers these from its flattened ASNs, which
+	 * must agree with the segment walk done on an uninterned copy
+	 */
+	asdup = aspath_dup(as);
+	if ((aspath_loop_check(as, sp->does_loop)
+	     != aspath_loop_check(asdup, sp->does_loop))
+	    || (aspath_loop_check(as, sp->doesnt_loop)
+		!= aspath_loop_check(asdup, sp->doesnt_loop))
+	    || (aspath_loop_check_confed(as, sp->does_loop)
+		!= aspath_loop_check_confed(asdup, sp->does_loop))
+	    || (aspath_private_as_check(as)
+		!= aspath_private_as_check(asdup))) {
+		failed++;
+		fails++;
+		printf("flattened checks differ from segment walk\n");
+	}
+	aspath_free(asdup);
 	aspath_unintern(&asinout);
 	aspath_unintern(&as4);
 
@@ -0,0 +1,254 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/*
+ * AS-path token regex matcher equivalence tests
+ */
+#include <zebra.h>
+
+#include "vty.h"
+#include "stream.h"
+#include "privs.h"
+#include "memory.h"
+#include "queue.h"
+#include "filter.h"
+#include "frregex_real.h"
+
+#include "bgpd/bgpd.h"
+#include "bgpd/bgp_aspath.h"
+#include "bgpd/bgp_regex.h"
+
+/* need these to link in libbgp */
+struct zebra_privs_t bgpd_privs = {};
+struct event_loop *master = NULL;
+
+static int failed = 0;
+
+/* regexes that the token matcher must take over */
+static const char *const token_regexes[] = {
+	"^$",
+	"_100_",
+	"^100_",
+	"_100$",
+	"^100$",
+	"_100_200_",
+	"^100_200$",
+	"_(100|200)_",
+	"^(1|10|100)_200_",
+	"_0_",
+	"_4294967295_",
+	NULL,
+};
+
+/* regexes that must be left to regexec */
+static const char *const string_regexes[] = {
+	".*",
+	"100",
+	"^100",
+	"100$",
+	"_0100_",
+	"_100_$",
+	"^_100_",
+	"_1.0_",
+	"_[0-9]+_",
+	"_100__200_",
+	"_(100)200_",
+	"_4294967296_",
+	NULL,
+};
+
+/* paths to match both sorts of regex against */
+static const char *const paths[] = {
+	"",
+	"100",
+	"200",
+	"1000",
+	"1100",
+	"10 100",
+	"100 200",
+	"100 100 200",
+	"200 100",
+	"1 200 100 300",
+	"100 2000",
+	"4294967295",
+	"{100,200}",
+	"100 {200}",
+	"(100 200) 300",
+	"[100] 200",
+	NULL,
+};
+
+static int check(const char *regstr, struct aspath *as, bool *decided)
+{
+	struct frregex *regex;
+	struct bgp_asregex *asreg;
+	int expect, got;
+
+	regex = bgp_regcomp(regstr);
+	asreg = bgp_asregcomp(regstr);
+	if (!regex) {
+		printf("can't compile %s\n", regstr);
+		bgp_asregex_free(asreg);
+		return 1;
+	}
+
+	expect = bgp_regexec(regex, as) != REG_NOMATCH;
+	got = asreg ? bgp_asregexec(asreg, as) : -1;
+
+	bgp_regex_free(regex);
+	if (asreg)
+		bgp_asregex_free(asreg);
+
+	if (decided)
+		*decided = (got >= 0);
+	if (got < 0 || got == expect)
+		return 0;
+
+	printf("regex '%s' path '%s': regexec %d token %d\n", regstr,
+	       aspath_print(as), expect, got);
+	return 1;
+}
+
+static void compile_test(void)
+{
+	struct bgp_asregex *asreg;
+	int fails = 0;
+	int i;
+
+	printf("compile\n");
+
+	for (i = 0; token_regexes[i]; i++) {
+		asreg = bgp_asregcomp(token_regexes[i]);
+		if (!asreg) {
+			printf("not taken: %s\n", token_regexes[i]);
+			fails++;
+		}
+		bgp_asregex_free(asreg);
+	}
+	for (i = 0; string_regexes[i]; i++) {
+		asreg = bgp_asregcomp(string_regexes[i]);
+		if (asreg) {
+			printf("taken: %s\n", string_regexes[i]);
+			fails++;
+			bgp_asregex_free(asreg);
+		}
+	}
+
+	failed += fails;
+	printf("%s\n\n", fails ? "failed" : "OK");
+}
+
+static void fixed_test(void)
+{
+	struct aspath *as;
+	int fails = 0;
+	int i, j;
+
+	printf("fixed paths\n");
+
+	for (i = 0; paths[i]; i++) {
+		as = aspath_str2aspath(paths[i], ASNOTATION_PLAIN);
+		assert(as);
+
+		for (j = 0; token_regexes[j]; j++)
+			fails += check(token_regexes[j], as, NULL);
+		for (j = 0; string_regexes[j]; j++)
+			fails += check(string_regexes[j], as, NULL);
+
+		aspath_free(as);
+	}
+
+	failed += fails;
+	printf("%s\n\n", fails ? "failed" : "OK");
+}
+
+/* Small ASN alphabet so that random paths and regexes overlap a lot,
+ * including ASNs that are digit-prefixes of each other.
+ */
+static const char *const asns[] = { "1", "10", "100", "2", "20", "21" };
+
+static unsigned int lcg_state = 1;
+
+static unsigned int lcg(unsigned int mod)
+{
+	lcg_state = lcg_state * 1103515245 + 12345;
+	return (lcg_state >> 16) % mod;
+}
+
+static void random_regex(char *buf, size_t len)
+{
+	unsigned int ntok = 1 + lcg(3);
+	unsigned int t, n;
+
+	buf[0] = '\0';
+	strlcat(buf, lcg(2) ? "^" : "_", len);
+
+	for (t = 0; t < ntok; t++) {
+		if (t)
+			strlcat(buf, "_", len);
+		if (lcg(4) == 0) {
+			strlcat(buf, "(", len);
+			for (n = 0; n < 2; n++) {
+				if (n)
+					strlcat(buf, "|", len);
+				strlcat(buf, asns[lcg(array_size(asns))], len);
+			}
+			strlcat(buf, ")", len);
+		} else
+			strlcat(buf, asns[lcg(array_size(asns))], len);
+	}
+
+	strlcat(buf, lcg(2) ? "$" : "_", len);
+}
+
+static void random_path(char *buf, size_t len)
+{
+	unsigned int nasn = lcg(5);
+	unsigned int i;
+
+	buf[0] = '\0';
+	for (i = 0; i < nasn; i++) {
+		if (i)
+			strlcat(buf, " ", len);
+		strlcat(buf, asns[lcg(array_size(asns))], len);
+	}
+}
+
+static void random_test(void)
+{
+	char regstr[128], pathstr[128];
+	struct aspath *as;
+	bool decided;
+	int fails = 0;
+	int i;
+
+	printf("random paths\n");
+
+	for (i = 0; i < 20000; i++) {
+		random_regex(regstr, sizeof(regstr));
+		random_path(pathstr, sizeof(pathstr));
+
+		as = aspath_str2aspath(pathstr, ASNOTATION_PLAIN);
+		assert(as);
+
+		fails += check(regstr, as, &decided);
+		if (!decided) {
+			printf("undecided: regex '%s' path '%s'\n", regstr,
+			       pathstr);
+			fails++;
+		}
+
+		aspath_free(as);
+	}
+
+	failed += fails;
+	printf("%s\n\n", fails ? "failed" : "OK");
+}
+
+int main(void)
+{
+	compile_test();
+	fixed_test();
+	random_test();
+
+	printf("failures: %d\n", failed);
+	return failed;
+}
@@ -0,0 +1,11 @@
+# SPDX-License-Identifier: GPL-2.0-or-later
+import frrtest
+
+
+class TestAspathRegex(frrtest.TestMultiOut):
+    program = "./test_aspath_regex"
+
+
+TestAspathRegex.okfail("compile")
+TestAspathRegex.okfail("fixed paths")
+TestAspathRegex.okfail("random paths")
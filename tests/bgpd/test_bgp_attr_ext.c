@@ -0,0 +1,308 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/*
+ * BGP attribute extension block tests
+ */
+#include <zebra.h>
+
+#include "qobj.h"
+#include "vty.h"
+#include "stream.h"
+#include "privs.h"
+#include "memory.h"
+#include "queue.h"
+#include "filter.h"
+
+#include "bgpd/bgpd.h"
+#include "bgpd/bgp_attr.h"
+#include "bgpd/bgp_aspath.h"
+#include "bgpd/bgp_evpn.h"
+#include "bgpd/bgp_label.h"
+#include "bgpd/bgp_memory.h"
+#include "bgpd/bgp_network.h"
+#include "bgpd/bgp_vty.h"
+
+/* need these to link in libbgp */
+struct zebra_privs_t bgpd_privs = {};
+struct event_loop *master = NULL;
+
+static int failed = 0;
+
+static struct bgp *bgp;
+static as_t asn = 100;
+
+#define CHECK(cond)                                                            \
+	do {                                                                   \
+		if (!(cond)) {                                                 \
+			printf("  line %d: %s\n", __LINE__, #cond);            \
+			fails++;                                               \
+		}                                                              \
+	} while (0)
+
+static size_t ext_count(void)
+{
+	return MTYPE_BGP_ATTR_EXT->n_alloc;
+}
+
+/* interned attrs share one block, which lives as long as they do */
+static int intern_test(void)
+{
+	struct attr attr1, attr2;
+	struct attr *a1, *a2;
+	size_t base = ext_count();
+	int fails = 0;
+
+	bgp_attr_default_set(&attr1, bgp, BGP_ORIGIN_IGP);
+	bgp_attr_set_aigp_metric(&attr1, 100);
+	CHECK(attr1.ext && attr1.ext->refcnt == 0);
+	CHECK(ext_count() == base + 1);
+
+	a1 = bgp_attr_intern(&attr1);
+	CHECK(a1->ext && a1->ext->refcnt == 1);
+	CHECK(attr1.ext == a1->ext);
+	CHECK(ext_count() == base + 1);
+
+	/* an equal private block is dropped in favour of the interned one */
+	bgp_attr_default_set(&attr2, bgp, BGP_ORIGIN_IGP);
+	bgp_attr_set_aigp_metric(&attr2, 100);
+	CHECK(ext_count() == base + 2);
+
+	a2 = bgp_attr_intern(&attr2);
+	CHECK(a2 == a1);
+	CHECK(a1->ext->refcnt == 2);
+	CHECK(ext_count() == base + 1);
+
+	bgp_attr_unintern(&a2);
+	CHECK(a1->ext->refcnt == 1);
+	CHECK(ext_count() == base + 1);
+
+	bgp_attr_unintern(&a1);
+	CHECK(a1 == NULL);
+	CHECK(ext_count() == base);
+
+	aspath_unintern(&attr1.aspath);
+	aspath_unintern(&attr2.aspath);
+	return fails;
+}
+
+/* a block holding only default values is not kept */
+static int default_test(void)
+{
+	struct attr attr;
+	struct attr *a;
+	size_t base = ext_count();
+	int fails = 0;
+
+	bgp_attr_default_set(&attr, bgp, BGP_ORIGIN_IGP);
+
+	/* setting a default value on an attr without a block is a no-op */
+	bgp_attr_set_mm_seqnum(&attr, 0);
+	bgp_attr_set_aigp_metric(&attr, 0);
+	CHECK(attr.ext == NULL);
+
+	bgp_attr_set_aigp_metric(&attr, 10);
+	bgp_attr_set_aigp_metric(&attr, 0);
+	CHECK(attr.ext != NULL);
+	CHECK(ext_count() == base + 1);
+
+	a = bgp_attr_intern(&attr);
+	CHECK(a->ext == NULL);
+	CHECK(attr.ext == NULL);
+	CHECK(ext_count() == base);
+
+	bgp_attr_unintern(&a);
+	aspath_unintern(&attr.aspath);
+	return fails;
+}
+
+/* attrs with and without an all-default block hash and compare alike */
+static int hash_test(void)
+{
+	struct attr attr1, attr2, attr3;
+	size_t base = ext_count();
+	int fails = 0;
+
+	bgp_attr_default_set(&attr1, bgp, BGP_ORIGIN_IGP);
+	attr2 = attr1;
+	attr3 = attr1;
+
+	bgp_attr_ext_get(&attr2);
+	CHECK(attr1.ext == NULL && attr2.ext != NULL);
+	CHECK(attrhash_cmp(&attr1, &attr2));
+	CHECK(attrhash_key_make(&attr1) == attrhash_key_make(&attr2));
+
+	bgp_attr_set_df(&attr2, 1, 200);
+	CHECK(!attrhash_cmp(&attr1, &attr2));
+	CHECK(!attrhash_cmp(&attr2, &attr1));
+
+	/* equal values in distinct blocks */
+	bgp_attr_set_df(&attr3, 1, 200);
+	CHECK(attr2.ext != attr3.ext);
+	CHECK(attrhash_cmp(&attr2, &attr3));
+	CHECK(attrhash_key_make(&attr2) == attrhash_key_make(&attr3));
+
+	bgp_attr_set_mm_sync_seqnum(&attr3, 5);
+	CHECK(!attrhash_cmp(&attr2, &attr3));
+
+	bgp_attr_ext_flush(&attr2);
+	bgp_attr_ext_flush(&attr3);
+	CHECK(ext_count() == base);
+
+	aspath_unintern(&attr1.aspath);
+	return fails;
+}
+
+/* a private block is changed in place, an interned one is copied first */
+static int cow_test(void)
+{
+	struct attr attr, tmp;
+	struct attr *a;
+	struct bgp_attr_ext *ext;
+	size_t base = ext_count();
+	int fails = 0;
+
+	bgp_attr_default_set(&attr, bgp, BGP_ORIGIN_IGP);
+	ext = bgp_attr_ext_get(&attr);
+	CHECK(ext && ext->refcnt == 0);
+	CHECK(bgp_attr_ext_get(&attr) == ext);
+	bgp_attr_set_mm_seqnum(&attr, 7);
+	CHECK(attr.ext == ext && ext->mm_seqnum == 7);
+	CHECK(ext_count() == base + 1);
+
+	a = bgp_attr_intern(&attr);
+	CHECK(a->ext && a->ext->refcnt == 1);
+
+	tmp = *a;
+	tmp.refcnt = 0;
+	bgp_attr_set_mm_seqnum(&tmp, 8);
+	CHECK(tmp.ext != a->ext);
+	CHECK(tmp.ext->refcnt == 0);
+	CHECK(mac_mobility_seqnum(&tmp) == 8);
+	CHECK(a->ext->mm_seqnum == 7 && a->ext->refcnt == 1);
+	CHECK(ext_count() == base + 2);
+
+	/* the copy keeps the values it did not change */
+	bgp_attr_set_aigp_metric(&tmp, 30);
+	CHECK(bgp_attr_get_aigp_metric(a) == 0);
+
+	bgp_attr_ext_flush(&tmp);
+	CHECK(tmp.ext == NULL);
+	CHECK(ext_count() == base + 1);
+
+	bgp_attr_unintern(&a);
+	CHECK(ext_count() == base);
+
+	aspath_unintern(&attr.aspath);
+	return fails;
+}
+
+/* a shallow copy of a stack attr gets its own block when unshared */
+static int unshare_test(void)
+{
+	struct attr attr, copy;
+	struct attr *a;
+	size_t base = ext_count();
+	int fails = 0;
+
+	bgp_attr_default_set(&attr, bgp, BGP_ORIGIN_IGP);
+	bgp_attr_set_pmsi_tnl_type(&attr, PMSI_TNLTYPE_INGR_REPL);
+
+	copy = attr;
+	bgp_attr_ext_unshare(&copy);
+	CHECK(copy.ext != attr.ext);
+	CHECK(bgp_attr_get_pmsi_tnl_type(&copy) == PMSI_TNLTYPE_INGR_REPL);
+	CHECK(ext_count() == base + 2);
+
+	/* interning the copy leaves the original's block alone */
+	a = bgp_attr_intern(&copy);
+	CHECK(attr.ext && attr.ext->refcnt == 0);
+	CHECK(attr.ext != a->ext);
+
+	/* an interned block is already shared and stays as it is */
+	copy = *a;
+	bgp_attr_ext_unshare(&copy);
+	CHECK(copy.ext == a->ext);
+
+	bgp_attr_ext_flush(&copy);
+	CHECK(copy.ext == a->ext);
+
+	bgp_attr_ext_flush(&attr);
+	CHECK(attr.ext == NULL);
+	CHECK(ext_count() == base + 1);
+
+	bgp_attr_unintern(&a);
+	CHECK(ext_count() == base);
+
+	aspath_unintern(&attr.aspath);
+	return fails;
+}
+
+/* re-advertising unchanged local EVPN routes must not leak blocks */
+static int evpn_test(void)
+{
+	struct ipaddr vtep = { .ipa_type = IPADDR_V4 };
+	struct ipaddr ip = { .ipa_type = IPADDR_V4 };
+	struct ethaddr mac = { .octet = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x01 } };
+	struct in_addr mcast_grp = {};
+	vni_t vni = 100;
+	size_t base;
+	int fails = 0;
+	int i;
+
+	inet_pton(AF_INET, "192.0.2.1", &vtep.ipaddr_v4);
+	inet_pton(AF_INET, "198.51.100.1", &ip.ipaddr_v4);
+
+	/* the type-3 route carries a PMSI tunnel, hence a block */
+	CHECK(bgp_evpn_local_vni_add(bgp, vni, &vtep, VRF_DEFAULT, mcast_grp,
+				     0) == 0);
+	/* a type-2 route with a MAC mobility sequence number has one too */
+	CHECK(bgp_evpn_local_macip_add(bgp, vni, &mac, &ip, 0, 1, NULL) == 0);
+
+	base = ext_count();
+	CHECK(base > 0);
+
+	for (i = 0; i < 10; i++) {
+		CHECK(bgp_evpn_local_macip_add(bgp, vni, &mac, &ip, 0, 1,
+					       NULL) == 0);
+		bgp_evpn_flood_control_change(bgp);
+	}
+
+	CHECK(ext_count() == base);
+	return fails;
+}
+
+static void run_test(const char *name, int (*test)(void))
+{
+	int fails;
+
+	printf("%s\n", name);
+	fails = test();
+	failed += fails;
+	printf("%s\n\n", fails ? "failed" : "OK");
+}
+
+int main(void)
+{
+	qobj_init();
+	cmd_init(0);
+	bgp_vty_init();
+	master = event_master_create("test bgp attr ext");
+	bgp_master_init(master, BGP_SOCKET_SNDBUF_SIZE, list_new());
+	vrf_init(NULL, NULL, NULL, NULL);
+	bgp_option_set(BGP_OPT_NO_LISTEN);
+	bgp_attr_init();
+	bgp_labels_init();
+
+	if (bgp_get(&bgp, &asn, NULL, BGP_INSTANCE_TYPE_DEFAULT, NULL,
+		    ASNOTATION_PLAIN) < 0)
+		return -1;
+
+	run_test("intern", intern_test);
+	run_test("all-default", default_test);
+	run_test("hash and compare", hash_test);
+	run_test("copy on write", cow_test);
+	run_test("unshare", unshare_test);
+	run_test("evpn re-advertise", evpn_test);
+
+	printf("failures: %d\n", failed);
+	return failed;
+}
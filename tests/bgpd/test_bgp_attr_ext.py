@@ -0,0 +1,14 @@
+# SPDX-License-Identifier: GPL-2.0-or-later
+import frrtest
+
+
+class TestBgpAttrExt(frrtest.TestMultiOut):
+    program = "./test_bgp_attr_ext"
+
+
+TestBgpAttrExt.okfail("intern")
+TestBgpAttrExt.okfail("all-default")
+TestBgpAttrExt.okfail("hash and compare")
+TestBgpAttrExt.okfail("copy on write")
+TestBgpAttrExt.okfail("unshare")
+TestBgpAttrExt.okfail("evpn re-advertise")
@@ -0,0 +1,267 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/*
+ * BGP route-map memoization tests
+ */
+#include <zebra.h>
+
+#include "qobj.h"
+#include "vty.h"
+#include "stream.h"
+#include "privs.h"
+#include "memory.h"
+#include "queue.h"
+#include "filter.h"
+#include "routemap.h"
+
+#include "bgpd/bgpd.h"
+#include "bgpd/bgp_attr.h"
+#include "bgpd/bgp_aspath.h"
+#include "bgpd/bgp_route.h"
+#include "bgpd/bgp_label.h"
+#include "bgpd/bgp_network.h"
+#include "bgpd/bgp_vty.h"
+
+/* need these to link in libbgp */
+struct zebra_privs_t bgpd_privs = {};
+struct event_loop *master = NULL;
+
+static int failed = 0;
+
+static struct bgp *bgp;
+static struct peer *peer;
+static as_t asn = 100;
+
+/* invocation counters of the route-maps under test */
+#define NCOUNTERS 6
+static uint64_t *counters[NCOUNTERS];
+
+/*
+ * route-map MEMO permit 10
+ *  match metric 10
+ *  set local-preference 200
+ * route-map MEMO deny 20
+ *  match metric 20
+ * route-map MEMO permit 30
+ *  set weight 7
+ *  call MEMO-SUB
+ * route-map MEMO-SUB permit 10
+ *  match metric 30
+ *  set local-preference 300
+ * route-map MEMO-SUB permit 20
+ */
+static struct route_map *build_route_maps(void)
+{
+	struct route_map *map, *sub;
+	struct route_map_index *index;
+	int n = 0;
+
+	map = route_map_get("MEMO");
+	counters[n++] = &map->applied;
+
+	index = route_map_index_get(map, RMAP_PERMIT, 10);
+	route_map_add_match(index, "metric", "10", RMAP_EVENT_MATCH_ADDED);
+	route_map_add_set(index, "local-preference", "200");
+	counters[n++] = &index->applied;
+
+	index = route_map_index_get(map, RMAP_DENY, 20);
+	route_map_add_match(index, "metric", "20", RMAP_EVENT_MATCH_ADDED);
+	counters[n++] = &index->applied;
+
+	index = route_map_index_get(map, RMAP_PERMIT, 30);
+	route_map_add_set(index, "weight", "7");
+	index->nextrm = XSTRDUP(MTYPE_ROUTE_MAP_NAME, "MEMO-SUB");
+
+	sub = route_map_get("MEMO-SUB");
+	counters[n++] = &sub->applied;
+
+	index = route_map_index_get(sub, RMAP_PERMIT, 10);
+	route_map_add_match(index, "metric", "30", RMAP_EVENT_MATCH_ADDED);
+	route_map_add_set(index, "local-preference", "300");
+	counters[n++] = &index->applied;
+
+	index = route_map_index_get(sub, RMAP_PERMIT, 20);
+	counters[n++] = &index->applied;
+
+	assert(n == NCOUNTERS);
+	return map;
+}
+
+static void counters_get(uint64_t *values)
+{
+	int i;
+
+	for (i = 0; i < NCOUNTERS; i++)
+		values[i] = *counters[i];
+}
+
+static void attr_init(struct attr *attr, uint32_t med)
+{
+	bgp_attr_default_set(attr, bgp, BGP_ORIGIN_IGP);
+	attr->med = med;
+	bgp_attr_set(attr, BGP_ATTR_MULTI_EXIT_DISC);
+}
+
+static route_map_result_t apply(struct route_map *map, struct bgp_rmap_memo *memo,
+				struct attr *attr, uint64_t *delta)
+{
+	struct bgp_path_info path = {};
+	struct prefix p;
+	uint64_t before[NCOUNTERS];
+	route_map_result_t ret;
+	int i;
+
+	str2prefix("192.0.2.0/24", &p);
+	path.peer = peer;
+	path.attr = attr;
+
+	counters_get(before);
+	if (memo)
+		ret = bgp_route_map_apply_memo(memo, map, &p, &path, peer);
+	else
+		ret = route_map_apply(map, &p, &path);
+	counters_get(delta);
+
+	for (i = 0; i < NCOUNTERS; i++)
+		delta[i] -= before[i];
+
+	return ret;
+}
+
+/* a memoized application must look exactly like a fresh one */
+static int compare(struct route_map *map, struct bgp_rmap_memo *memo, uint32_t med)
+{
+	struct attr fresh, memoized;
+	uint64_t fresh_delta[NCOUNTERS], memo_delta[NCOUNTERS];
+	route_map_result_t fresh_ret, memo_ret;
+	int fails = 0;
+	int i;
+
+	attr_init(&fresh, med);
+	attr_init(&memoized, med);
+
+	fresh_ret = apply(map, NULL, &fresh, fresh_delta);
+	memo_ret = apply(map, memo, &memoized, memo_delta);
+
+	if (fresh_ret != memo_ret) {
+		printf("  med %u: result %d, memoized %d\n", med, fresh_ret,
+		       memo_ret);
+		fails++;
+	} else if (fresh_ret != RMAP_DENYMATCH &&
+		   !attrhash_cmp(&fresh, &memoized)) {
+		printf("  med %u: attributes differ\n", med);
+		fails++;
+	}
+
+	for (i = 0; i < NCOUNTERS; i++) {
+		if (fresh_delta[i] == memo_delta[i])
+			continue;
+
+		printf("  med %u: counter %d bumped by %" PRIu64
+		       ", memoized by %" PRIu64 "\n",
+		       med, i, fresh_delta[i], memo_delta[i]);
+		fails++;
+	}
+
+	aspath_unintern(&fresh.aspath);
+	aspath_unintern(&memoized.aspath);
+	return fails;
+}
+
+/* each index taken, first applied and then found in the memo */
+static void hit_test(struct route_map *map)
+{
+	static const uint32_t meds[] = { 10, 20, 30, 40 };
+	struct bgp_rmap_memo *memo = bgp_rmap_memo_new();
+	int fails = 0;
+	unsigned int i;
+
+	printf("memo hits\n");
+
+	for (i = 0; i < array_size(meds); i++) {
+		fails += compare(map, memo, meds[i]);
+		fails += compare(map, memo, meds[i]);
+	}
+
+	if (bgp_rmap_memo_count(memo) != array_size(meds)) {
+		printf("  %lu entries, expected %zu\n",
+		       bgp_rmap_memo_count(memo), array_size(meds));
+		fails++;
+	}
+
+	bgp_rmap_memo_free(&memo);
+
+	failed += fails;
+	printf("%s\n\n", fails ? "failed" : "OK");
+}
+
+/* a full memo is emptied, and results stay right across that */
+static void evict_test(struct route_map *map)
+{
+	struct bgp_rmap_memo *memo = bgp_rmap_memo_new();
+	unsigned long count;
+	bool evicted = false;
+	int fails = 0;
+	uint32_t med;
+
+	printf("memo eviction\n");
+
+	for (med = 0; med <= BGP_RMAP_MEMO_MAX + 10; med++) {
+		count = bgp_rmap_memo_count(memo);
+		fails += compare(map, memo, med);
+
+		if (bgp_rmap_memo_count(memo) > BGP_RMAP_MEMO_MAX) {
+			printf("  %lu entries past the limit\n",
+			       bgp_rmap_memo_count(memo));
+			fails++;
+		}
+		if (bgp_rmap_memo_count(memo) < count)
+			evicted = true;
+	}
+
+	if (!evicted) {
+		printf("  memo never emptied\n");
+		fails++;
+	}
+
+	/* results dropped from the memo are computed again */
+	fails += compare(map, memo, 10);
+	fails += compare(map, memo, 20);
+	fails += compare(map, memo, 30);
+	fails += compare(map, memo, 30);
+
+	bgp_rmap_memo_free(&memo);
+
+	failed += fails;
+	printf("%s\n\n", fails ? "failed" : "OK");
+}
+
+int main(void)
+{
+	struct route_map *map;
+
+	qobj_init();
+	cmd_init(0);
+	bgp_vty_init();
+	master = event_master_create("test bgp rmap memo");
+	bgp_master_init(master, BGP_SOCKET_SNDBUF_SIZE, list_new());
+	vrf_init(NULL, NULL, NULL, NULL);
+	bgp_option_set(BGP_OPT_NO_LISTEN);
+	bgp_attr_init();
+	bgp_labels_init();
+	bgp_route_map_init();
+
+	if (bgp_get(&bgp, &asn, NULL, BGP_INSTANCE_TYPE_DEFAULT, NULL,
+		    ASNOTATION_PLAIN) < 0)
+		return -1;
+
+	peer = peer_create_accept(bgp, NULL);
+	peer->host = (char *)"foo";
+
+	map = build_route_maps();
+
+	hit_test(map);
+	evict_test(map);
+
+	printf("failures: %d\n", failed);
+	return failed;
+}
@@ -0,0 +1,10 @@
+# SPDX-License-Identifier: GPL-2.0-or-later
+import frrtest
+
+
+class TestBgpRmapMemo(frrtest.TestMultiOut):
+    program = "./test_bgp_rmap_memo"
+
+
+TestBgpRmapMemo.okfail("memo hits")
+TestBgpRmapMemo.okfail("memo eviction")
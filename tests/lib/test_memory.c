@@ -7,6 +7,8 @@
 
 DEFINE_MGROUP(TEST_MEMORY, "memory test");
 DEFINE_MTYPE_STATIC(TEST_MEMORY, TEST, "generic test mtype");
+DEFINE_MTYPE_STATIC(TEST_MEMORY, TEST_POOL, "pool test mtype");
+DEFINE_MPOOL_STATIC(TEST_POOL, TEST_POOL, 120);
 
 /* Memory torture tests
  *
@@ -29,11 +31,14 @@ struct event_loop *master;
 #endif
 
 #define TIMES 10
+#define POOL_OBJS 20000
+
+static void *p[POOL_OBJS];
 
 int main(int argc, char **argv)
 {
 	void *a[10];
-	int i;
+	int i, j;
 
 	printf("malloc x, malloc x, free, malloc x, free free\n\n");
 	/* simple case, test cache */
@@ -102,5 +107,29 @@ int main(int argc, char **argv)
 		XFREE(MTYPE_TEST, a[2]);
 		/* alloc == 0, cache valid next request */
 	}
+
+	printf("pool alloc, free every other, realloc, free all\n\n");
+	/* objects must come back zeroed and stay accounted on the MTYPE */
+	for (i = 0; i < TIMES; i++) {
+		for (j = 0; j < POOL_OBJS; j++) {
+			p[j] = XPOOL_CALLOC(TEST_POOL);
+			memset(p[j], 1, 120);
+		}
+		assert(mtype_stats_alloc(MTYPE_TEST_POOL) == POOL_OBJS);
+
+		for (j = 0; j < POOL_OBJS; j += 2)
+			XPOOL_FREE(TEST_POOL, p[j]);
+		assert(mtype_stats_alloc(MTYPE_TEST_POOL) == POOL_OBJS / 2);
+
+		for (j = 0; j < POOL_OBJS; j += 2) {
+			p[j] = XPOOL_CALLOC(TEST_POOL);
+			assert(((char *)p[j])[0] == 0 &&
+			       ((char *)p[j])[119] == 0);
+		}
+
+		for (j = POOL_OBJS - 1; j >= 0; j--)
+			XPOOL_FREE(TEST_POOL, p[j]);
+		assert(mtype_stats_alloc(MTYPE_TEST_POOL) == 0);
+	}
 	return 0;
 }
@@ -0,0 +1,14 @@
+# SPDX-License-Identifier: GPL-2.0-or-later
+import frrtest
+
+
+class TestMemory(frrtest.TestMultiOut):
+    program = "./test_memory"
+
+
+TestMemory.onesimple("malloc x, malloc x, free, malloc x, free free")
+TestMemory.onesimple("malloc x, malloc y, free x, malloc y, free free")
+TestMemory.onesimple("calloc")
+TestMemory.onesimple("calloc and realloc")
+TestMemory.onesimple("pool alloc, free every other, realloc, free all")
+TestMemory.exit_cleanly()
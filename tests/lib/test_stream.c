@@ -33,7 +33,7 @@ static void print_stream(struct stream *s)
 
 int main(void)
 {
-	struct stream *s;
+	struct stream *s, *shared;
 
 	s = stream_new(1024);
 
@@ -53,6 +53,13 @@ int main(void)
 	printfrr("l: 0x%x\n", stream_getl(s));
 	printfrr("q: 0x%" PRIx64 "\n", stream_getq(s));
 
+	/* shared data must survive the original stream */
+	shared = stream_share(s);
+	stream_set_getp(shared, 0);
 	stream_free(s);
+
+	print_stream(shared);
+
+	stream_free(shared);
 	return 0;
 }
@@ -10,6 +10,8 @@
 #include "printfrr.h"
 #include "prefix.h"
 #include "table.h"
+#include "monotime.h"
+#include "prng.h"
 
 /*
  * test_node_t
@@ -501,6 +503,178 @@ static void test_info_count(void)
 	route_table_finish(table);
 }
 
+/*
+ * random_prefix
+ *
+ * Fill in a random, masked IPv4 or IPv6 prefix of at least min_len bits.
+ */
+static void random_prefix(struct prng *prng, int family, unsigned int min_len,
+			  struct prefix *p)
+{
+	unsigned int max_len, i;
+
+	memset(p, 0, sizeof(*p));
+	p->family = family;
+	max_len = family == AF_INET ? IPV4_MAX_BITLEN : IPV6_MAX_BITLEN;
+	p->prefixlen = min_len + prng_rand(prng) % (max_len - min_len + 1);
+
+	/* Keep the top byte in a small range so prefixes nest and overlap */
+	p->u.val[0] = 10 + prng_rand(prng) % 4;
+	for (i = 1; i < max_len / 8; i++)
+		p->u.val[i] = prng_rand(prng);
+	apply_mask(p);
+}
+
+/*
+ * random_host
+ *
+ * Fill in a random host address that falls inside the given prefix.
+ */
+static void random_host(struct prng *prng, const struct prefix *pfx,
+			struct prefix *addr)
+{
+	unsigned int i, bits;
+	uint8_t mask;
+
+	random_prefix(prng, pfx->family,
+		      pfx->family == AF_INET ? IPV4_MAX_BITLEN : IPV6_MAX_BITLEN,
+		      addr);
+
+	for (i = 0; i < addr->prefixlen / 8; i++) {
+		bits = pfx->prefixlen > i * 8 ? pfx->prefixlen - i * 8 : 0;
+		mask = bits >= 8 ? 0xff : (uint8_t)(0xff00 >> bits);
+		addr->u.val[i] = (pfx->u.val[i] & mask) |
+				 (addr->u.val[i] & ~mask);
+	}
+}
+
+/*
+ * fill_match_table
+ *
+ * Insert num_prefixes random prefixes into a new table, pointing each
+ * node's info at its prefix.
+ */
+static struct route_table *fill_match_table(struct prng *prng, int family,
+					    struct prefix *prefixes,
+					    unsigned int num_prefixes)
+{
+	struct route_table *table;
+	struct route_node *rn;
+	unsigned int i;
+
+	table = route_table_init();
+	for (i = 0; i < num_prefixes; i++) {
+		random_prefix(prng, family, 8, &prefixes[i]);
+		rn = route_node_get(table, &prefixes[i]);
+		if (rn->info)
+			route_unlock_node(rn);
+		else
+			route_node_set_info(rn, &prefixes[i]);
+	}
+
+	return table;
+}
+
+static void free_match_table(struct route_table *table)
+{
+	struct route_node *rn;
+
+	for (rn = route_top(table); rn; rn = route_next(rn)) {
+		if (!rn->info)
+			continue;
+		route_node_set_info(rn, NULL);
+		route_unlock_node(rn);
+	}
+
+	route_table_finish(table);
+}
+
+/*
+ * test_match
+ *
+ * Checks route_node_match() against a linear longest-prefix match over
+ * the inserted prefixes, then reports the lookup rate on a larger table.
+ */
+static void test_match(int family)
+{
+	struct route_table *table;
+	struct route_node *rn;
+	struct prefix *prefixes, *addrs;
+	const struct prefix *best;
+	struct prng *prng;
+	struct timeval start;
+	int64_t usec;
+	unsigned int num_prefixes, num_lookups, i, j, found;
+
+	printf("\n\nTesting route_node_match() for %s\n",
+	       family == AF_INET ? "IPv4" : "IPv6");
+
+	prng = prng_new(0);
+
+	num_prefixes = 2000;
+	num_lookups = 20000;
+	prefixes = calloc(num_prefixes, sizeof(*prefixes));
+	addrs = calloc(1, sizeof(*addrs));
+	assert(prefixes && addrs);
+
+	table = fill_match_table(prng, family, prefixes, num_prefixes);
+
+	for (i = 0; i < num_lookups; i++) {
+		random_host(prng, &prefixes[prng_rand(prng) % num_prefixes],
+			    addrs);
+
+		best = NULL;
+		for (j = 0; j < num_prefixes; j++)
+			if (prefix_match(&prefixes[j], addrs) &&
+			    (!best || prefixes[j].prefixlen > best->prefixlen))
+				best = &prefixes[j];
+
+		rn = route_node_match(table, addrs);
+		assert(rn && best);
+		assert(prefix_same(&rn->p, best));
+		route_unlock_node(rn);
+	}
+
+	free_match_table(table);
+	free(prefixes);
+	free(addrs);
+
+	printf("Verified route_node_match with %u lookups\n", num_lookups);
+
+	/* Lookup rate on a bigger table, for comparing changes to table.c */
+	num_prefixes = 200000;
+	num_lookups = 1000000;
+	prefixes = calloc(num_prefixes, sizeof(*prefixes));
+	addrs = calloc(num_lookups, sizeof(*addrs));
+	assert(prefixes && addrs);
+
+	table = fill_match_table(prng, family, prefixes, num_prefixes);
+	for (i = 0; i < num_lookups; i++)
+		random_host(prng, &prefixes[prng_rand(prng) % num_prefixes],
+			    &addrs[i]);
+
+	found = 0;
+	monotime(&start);
+	for (i = 0; i < num_lookups; i++) {
+		rn = route_node_match(table, &addrs[i]);
+		if (rn) {
+			found++;
+			route_unlock_node(rn);
+		}
+	}
+	usec = monotime_since(&start, NULL);
+
+	assert(found == num_lookups);
+	printf("%u lookups over %lu nodes in %" PRId64 " usec (%.0f lookups/s)\n",
+	       num_lookups, route_table_count(table), usec,
+	       usec ? num_lookups * 1000000.0 / usec : 0.0);
+
+	free_match_table(table);
+	free(prefixes);
+	free(addrs);
+	prng_free(prng);
+}
+
 /*
  * run_tests
  */
@@ -510,6 +684,8 @@ static void run_tests(void)
 	test_get_next();
 	test_iter_pause();
 	test_info_count();
+	test_match(AF_INET);
+	test_match(AF_INET6);
 }
 
 /*
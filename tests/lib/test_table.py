@@ -11,3 +11,5 @@ for i in range(6):
 for i in range(11):
     TestTable.onesimple("Verifying successor")
 TestTable.onesimple("Verified pausing")
+for i in range(2):
+    TestTable.onesimple("Verified route_node_match")
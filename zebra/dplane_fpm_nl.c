@@ -115,6 +115,16 @@ struct fpm_nl_ctx {
 	struct event *t_rmacreset;
 	struct event *t_rmacwalk;
 
+	/*
+	 * Where the RIB walk stopped when the output buffer filled up, so
+	 * the next run picks up from there instead of from the top.
+	 */
+	rib_tables_iter_t rib_walk_iter;
+	rib_tables_iter_t rib_walk_table;
+	struct prefix rib_walk_dst;
+	struct prefix_ipv6 rib_walk_src;
+	bool rib_walk_resume;
+
 	/* Statistic counters. */
 	struct {
 		/* Amount of bytes read into ibuf. */
@@ -951,7 +961,7 @@ static void fpm_connect(struct event *t)
  */
 static int fpm_nl_enqueue(struct fpm_nl_ctx *fnc, struct zebra_dplane_ctx *ctx)
 {
-	uint8_t nl_buf[DPLANE_FPM_NL_BUF_SIZE];
+	uint8_t *nl_buf;
 	size_t nl_buf_len;
 	ssize_t rv;
 	uint64_t obytes, obytes_peak;
@@ -966,6 +976,28 @@ static int fpm_nl_enqueue(struct fpm_nl_ctx *fnc, struct zebra_dplane_ctx *ctx)
 		|| op == DPLANE_OP_NH_UPDATE))
 		return 0;
 
+	frr_mutex_lock_autounlock(&fnc->obuf_mutex);
+
+	/*
+	 * Messages are encoded straight into the output buffer, after room
+	 * for the FPM header, so check for space for the largest one first.
+	 */
+	if (STREAM_WRITEABLE(fnc->obuf) <
+	    (DPLANE_FPM_NL_BUF_SIZE + FPM_HEADER_SIZE)) {
+		atomic_fetch_add_explicit(&fnc->counters.buffer_full, 1,
+					  memory_order_relaxed);
+
+		if (IS_ZEBRA_DEBUG_FPM)
+			zlog_debug("%s: buffer full: wants to write %u but has %zu",
+				   __func__,
+				   DPLANE_FPM_NL_BUF_SIZE + FPM_HEADER_SIZE,
+				   STREAM_WRITEABLE(fnc->obuf));
+
+		return -1;
+	}
+
+	nl_buf = STREAM_DATA(fnc->obuf) + stream_get_endp(fnc->obuf) +
+		 FPM_HEADER_SIZE;
 	nl_buf_len = 0;
 
 	/*
@@ -979,7 +1011,7 @@ static int fpm_nl_enqueue(struct fpm_nl_ctx *fnc, struct zebra_dplane_ctx *ctx)
 	case DPLANE_OP_ROUTE_UPDATE:
 	case DPLANE_OP_ROUTE_DELETE:
 		rv = netlink_route_multipath_msg_encode(RTM_DELROUTE, ctx,
-							nl_buf, sizeof(nl_buf),
+							nl_buf, DPLANE_FPM_NL_BUF_SIZE,
 							true, fnc->use_nhg,
 							false);
 		if (rv <= 0) {
@@ -999,7 +1031,7 @@ static int fpm_nl_enqueue(struct fpm_nl_ctx *fnc, struct zebra_dplane_ctx *ctx)
 	case DPLANE_OP_ROUTE_INSTALL:
 		rv = netlink_route_multipath_msg_encode(RTM_NEWROUTE, ctx,
 							&nl_buf[nl_buf_len],
-							sizeof(nl_buf) -
+							DPLANE_FPM_NL_BUF_SIZE -
 								nl_buf_len,
 							true, fnc->use_nhg,
 							fnc->use_route_replace);
@@ -1015,7 +1047,7 @@ static int fpm_nl_enqueue(struct fpm_nl_ctx *fnc, struct zebra_dplane_ctx *ctx)
 
 	case DPLANE_OP_MAC_INSTALL:
 	case DPLANE_OP_MAC_DELETE:
-		rv = netlink_macfdb_update_ctx(ctx, nl_buf, sizeof(nl_buf));
+		rv = netlink_macfdb_update_ctx(ctx, nl_buf, DPLANE_FPM_NL_BUF_SIZE);
 		if (rv <= 0) {
 			flog_err(EC_ZEBRA_FPM_ENCODE_FAIL, "%s: netlink_macfdb_update_ctx failed",
 				 __func__);
@@ -1028,7 +1060,7 @@ static int fpm_nl_enqueue(struct fpm_nl_ctx *fnc, struct zebra_dplane_ctx *ctx)
 
 	case DPLANE_OP_NH_DELETE:
 		rv = netlink_nexthop_msg_encode(RTM_DELNEXTHOP, ctx, nl_buf,
-						sizeof(nl_buf), true);
+						DPLANE_FPM_NL_BUF_SIZE, true);
 		if (rv <= 0) {
 			flog_err(EC_ZEBRA_FPM_ENCODE_FAIL, "%s: netlink_nexthop_msg_encode failed",
 				 __func__);
@@ -1042,7 +1074,7 @@ static int fpm_nl_enqueue(struct fpm_nl_ctx *fnc, struct zebra_dplane_ctx *ctx)
 	case DPLANE_OP_NH_INSTALL:
 	case DPLANE_OP_NH_UPDATE:
 		rv = netlink_nexthop_msg_encode(RTM_NEWNEXTHOP, ctx, nl_buf,
-						sizeof(nl_buf), true);
+						DPLANE_FPM_NL_BUF_SIZE, true);
 		if (rv <= 0) {
 			flog_err(EC_ZEBRA_FPM_ENCODE_FAIL, "%s: netlink_nexthop_msg_encode failed",
 				 __func__);
@@ -1056,7 +1088,7 @@ static int fpm_nl_enqueue(struct fpm_nl_ctx *fnc, struct zebra_dplane_ctx *ctx)
 	case DPLANE_OP_LSP_INSTALL:
 	case DPLANE_OP_LSP_UPDATE:
 	case DPLANE_OP_LSP_DELETE:
-		rv = netlink_lsp_msg_encoder(ctx, nl_buf, sizeof(nl_buf));
+		rv = netlink_lsp_msg_encoder(ctx, nl_buf, DPLANE_FPM_NL_BUF_SIZE);
 		if (rv <= 0) {
 			flog_err(EC_ZEBRA_FPM_ENCODE_FAIL, "%s: netlink_lsp_msg_encoder failed",
 				 __func__);
@@ -1125,22 +1157,6 @@ static int fpm_nl_enqueue(struct fpm_nl_ctx *fnc, struct zebra_dplane_ctx *ctx)
 	/* We must know if someday a message goes beyond 65KiB. */
 	assert((nl_buf_len + FPM_HEADER_SIZE) <= UINT16_MAX);
 
-	frr_mutex_lock_autounlock(&fnc->obuf_mutex);
-
-	/* Check if we have enough buffer space. */
-	if (STREAM_WRITEABLE(fnc->obuf) < (nl_buf_len + FPM_HEADER_SIZE)) {
-		atomic_fetch_add_explicit(&fnc->counters.buffer_full, 1,
-					  memory_order_relaxed);
-
-		if (IS_ZEBRA_DEBUG_FPM)
-			zlog_debug(
-				"%s: buffer full: wants to write %zu but has %zu",
-				__func__, nl_buf_len + FPM_HEADER_SIZE,
-				STREAM_WRITEABLE(fnc->obuf));
-
-		return -1;
-	}
-
 	/*
 	 * Fill in the FPM header information.
 	 *
@@ -1150,8 +1166,8 @@ static int fpm_nl_enqueue(struct fpm_nl_ctx *fnc, struct zebra_dplane_ctx *ctx)
 	stream_putc(fnc->obuf, 1);
 	stream_putw(fnc->obuf, nl_buf_len + FPM_HEADER_SIZE);
 
-	/* Write current data. */
-	stream_write(fnc->obuf, nl_buf, (size_t)nl_buf_len);
+	/* The data is already in place, just account for it. */
+	stream_forward_endp(fnc->obuf, nl_buf_len);
 
 	/* Account number of bytes waiting to be written. */
 	atomic_fetch_add_explicit(&fnc->counters.obuf_bytes,
@@ -1289,6 +1305,45 @@ static void fpm_nhg_send(struct event *t)
 				&fnc->t_nhgwalk);
 }
 
+/*
+ * Find the node the RIB walk stopped at, or the one after it if it has
+ * since gone away.
+ */
+static struct route_node *fpm_rib_walk_resume(struct fpm_nl_ctx *fnc,
+					      struct route_table *rt)
+{
+	const struct prefix_ipv6 *src_p = NULL;
+	struct route_node *rn;
+
+	if (fnc->rib_walk_src.prefixlen)
+		src_p = &fnc->rib_walk_src;
+
+	rn = srcdest_rnode_lookup(rt, &fnc->rib_walk_dst, src_p);
+	if (rn)
+		return rn;
+
+	return srcdest_table_get_next(rt, &fnc->rib_walk_dst, src_p);
+}
+
+static void fpm_rib_walk_save(struct fpm_nl_ctx *fnc,
+			      const rib_tables_iter_t *rt_iter_prev,
+			      const rib_tables_iter_t *rt_iter,
+			      const struct route_node *rn)
+{
+	const struct prefix *dst_p, *src_p;
+
+	srcdest_rnode_prefixes(rn, &dst_p, &src_p);
+
+	fnc->rib_walk_iter = *rt_iter_prev;
+	fnc->rib_walk_table = *rt_iter;
+	prefix_copy(&fnc->rib_walk_dst, dst_p);
+	if (src_p)
+		prefix_copy(&fnc->rib_walk_src, src_p);
+	else
+		memset(&fnc->rib_walk_src, 0, sizeof(fnc->rib_walk_src));
+	fnc->rib_walk_resume = true;
+}
+
 /**
  * Send all RIB installed routes to the connected data plane.
  */
@@ -1299,14 +1354,33 @@ static void fpm_rib_send(struct event *t)
 	struct route_node *rn;
 	struct route_table *rt;
 	struct zebra_dplane_ctx *ctx;
-	rib_tables_iter_t rt_iter;
+	rib_tables_iter_t rt_iter, rt_iter_cur;
 
 	/* Allocate temporary context for all transactions. */
 	ctx = dplane_ctx_alloc();
 
-	rt_iter.state = RIB_TABLES_ITER_S_INIT;
-	while ((rt = rib_tables_iter_next(&rt_iter))) {
-		for (rn = route_top(rt); rn; rn = srcdest_route_next(rn)) {
+	/*
+	 * Continue from the table we stopped in last time: the saved
+	 * iterator state is the one from just before that table was
+	 * returned.
+	 */
+	rt_iter = fnc->rib_walk_iter;
+	while (true) {
+		rt_iter_cur = rt_iter;
+		rt = rib_tables_iter_next(&rt_iter);
+		if (rt == NULL)
+			break;
+
+		/* Only resume if the table is still there */
+		if (fnc->rib_walk_resume &&
+		    rt_iter.vrf_id == fnc->rib_walk_table.vrf_id &&
+		    rt_iter.afi_safi_ix == fnc->rib_walk_table.afi_safi_ix)
+			rn = fpm_rib_walk_resume(fnc, rt);
+		else
+			rn = route_top(rt);
+		fnc->rib_walk_resume = false;
+
+		for (; rn; rn = srcdest_route_next(rn)) {
 			dest = rib_dest_from_rnode(rn);
 			/* Skip bad route entries. */
 			if (dest == NULL || dest->selected_fib == NULL)
@@ -1324,6 +1398,11 @@ static void fpm_rib_send(struct event *t)
 				/* Free the temporary allocated context. */
 				dplane_ctx_fini(&ctx);
 
+				/* Remember where to pick up from. */
+				fpm_rib_walk_save(fnc, &rt_iter_cur, &rt_iter,
+						  rn);
+				route_unlock_node(rn);
+
 				event_add_timer(zrouter.master, fpm_rib_send,
 						fnc, 1, &fnc->t_ribwalk);
 				return;
@@ -1476,6 +1555,10 @@ static void fpm_rib_reset(struct event *t)
 		}
 	}
 
+	/* Start the RIB walk over from the top. */
+	fnc->rib_walk_iter.state = RIB_TABLES_ITER_S_INIT;
+	fnc->rib_walk_resume = false;
+
 	/* Schedule next step: send RIB routes. */
 	event_add_event(zrouter.master, fpm_rib_send, fnc, 0, &fnc->t_ribwalk);
 }
@@ -1535,7 +1618,8 @@ static void fpm_process_queue(struct event *t)
 		}
 
 		/* No space available yet. */
-		if (writeable_amount < DPLANE_FPM_NL_BUF_SIZE) {
+		if (writeable_amount <
+		    (DPLANE_FPM_NL_BUF_SIZE + FPM_HEADER_SIZE)) {
 			no_bufs = true;
 			break;
 		}
@@ -180,6 +180,19 @@ char *nl_batch_tx_buf;
 _Atomic uint32_t nl_batch_bufsize = NL_DEFAULT_BATCH_BUFSIZE;
 _Atomic uint32_t nl_batch_send_threshold = NL_DEFAULT_BATCH_SEND_THRESHOLD;
 
+/*
+ * Batch statistics, for 'show zebra dplane detailed'. The latency buckets
+ * cover the time from handing a batch to the kernel until all of its
+ * responses have been read, in decades of microseconds starting at 10us.
+ */
+#define NL_BATCH_LAT_BUCKETS 6
+
+static _Atomic uint64_t nl_batch_sends;
+static _Atomic uint64_t nl_batch_msgs;
+static _Atomic uint64_t nl_batch_msgs_max;
+static _Atomic uint64_t nl_batch_errors;
+static _Atomic uint64_t nl_batch_lat[NL_BATCH_LAT_BUCKETS];
+
 struct nl_batch {
 	void *buf;
 	size_t bufsiz;
@@ -1323,12 +1336,17 @@ static void nl_batch_send(struct nl_batch *bth)
 	if (bth->curlen != 0 && bth->zns != NULL) {
 		struct nlsock *nl =
 			kernel_netlink_nlsock_lookup(bth->zns->sock);
+		struct timeval start;
+		int64_t usec;
+		unsigned int bucket;
 
 		if (IS_ZEBRA_DEBUG_KERNEL)
 			zlog_debug("%s: %s, batch size=%zu, msg cnt=%zu",
 				   __func__, nl->name, bth->curlen,
 				   bth->msgcnt);
 
+		monotime(&start);
+
 		if (netlink_send_msg(nl, bth->buf, bth->curlen) == -1)
 			err = true;
 
@@ -1336,6 +1354,26 @@ static void nl_batch_send(struct nl_batch *bth)
 			if (nl_batch_read_resp(bth, nl) == -1)
 				err = true;
 		}
+
+		usec = monotime_since(&start, NULL);
+		for (bucket = 0; bucket < NL_BATCH_LAT_BUCKETS - 1 && usec >= 10;
+		     bucket++)
+			usec /= 10;
+
+		atomic_fetch_add_explicit(&nl_batch_sends, 1,
+					  memory_order_relaxed);
+		atomic_fetch_add_explicit(&nl_batch_msgs, bth->msgcnt,
+					  memory_order_relaxed);
+		atomic_fetch_add_explicit(&nl_batch_lat[bucket], 1,
+					  memory_order_relaxed);
+		if (err)
+			atomic_fetch_add_explicit(&nl_batch_errors, 1,
+						  memory_order_relaxed);
+		/* Only the dplane pthread sends batches */
+		if (bth->msgcnt > atomic_load_explicit(&nl_batch_msgs_max,
+						       memory_order_relaxed))
+			atomic_store_explicit(&nl_batch_msgs_max, bth->msgcnt,
+					      memory_order_relaxed);
 	}
 
 	/* Move remaining contexts to the outbound queue. */
@@ -1509,6 +1547,92 @@ static enum netlink_msg_status nl_put_msg(struct nl_batch *bth,
 	return FRR_NETLINK_ERROR;
 }
 
+void kernel_update_multi_show(struct vty *vty)
+{
+	static const char *const lat_names[NL_BATCH_LAT_BUCKETS] = {
+		"< 10us", "< 100us", "< 1ms", "< 10ms", "< 100ms", ">= 100ms",
+	};
+	unsigned int i;
+
+	vty_out(vty, "Netlink batches sent:     %" PRIu64 "\n",
+		atomic_load_explicit(&nl_batch_sends, memory_order_relaxed));
+	vty_out(vty, "Netlink batch messages:   %" PRIu64 "\n",
+		atomic_load_explicit(&nl_batch_msgs, memory_order_relaxed));
+	vty_out(vty, "Netlink batch max msgs:   %" PRIu64 "\n",
+		atomic_load_explicit(&nl_batch_msgs_max, memory_order_relaxed));
+	vty_out(vty, "Netlink batch errors:     %" PRIu64 "\n",
+		atomic_load_explicit(&nl_batch_errors, memory_order_relaxed));
+	vty_out(vty, "Netlink batch latency:\n");
+	for (i = 0; i < NL_BATCH_LAT_BUCKETS; i++)
+		vty_out(vty, "  %-9s %" PRIu64 "\n", lat_names[i],
+			atomic_load_explicit(&nl_batch_lat[i],
+					     memory_order_relaxed));
+}
+
+/*
+ * Route and nexthop updates for different namespaces are independent of
+ * each other, so they may be reordered across namespaces.
+ */
+static bool nl_batch_ctx_groupable(const struct zebra_dplane_ctx *ctx)
+{
+	enum dplane_op_e op = dplane_ctx_get_op(ctx);
+
+	return op == DPLANE_OP_ROUTE_INSTALL || op == DPLANE_OP_ROUTE_UPDATE ||
+	       op == DPLANE_OP_ROUTE_DELETE || op == DPLANE_OP_NH_INSTALL ||
+	       op == DPLANE_OP_NH_UPDATE || op == DPLANE_OP_NH_DELETE;
+}
+
+/*
+ * Reorder the incoming list so that each run of route/nexthop contexts is
+ * grouped by namespace. With netns vrfs, updates for several namespaces
+ * tend to arrive interleaved, and since a batch only ever targets one
+ * namespace socket each switch forces a send and a wait for the kernel's
+ * responses. Order within a namespace is preserved, so updates for the
+ * same prefix (or nexthop id) are still applied in the order they were
+ * queued, and any other kind of context acts as a barrier.
+ */
+static void nl_batch_group_ns(struct dplane_ctx_list_head *ctx_list)
+{
+	struct dplane_ctx_list_head out_list, run_list, rest_list;
+	struct zebra_dplane_ctx *ctx;
+	ns_id_t ns_id;
+
+	dplane_ctx_q_init(&out_list);
+	dplane_ctx_q_init(&run_list);
+	dplane_ctx_q_init(&rest_list);
+
+	while ((ctx = dplane_ctx_dequeue(ctx_list)) != NULL) {
+		if (!nl_batch_ctx_groupable(ctx)) {
+			dplane_ctx_enqueue_tail(&out_list, ctx);
+			continue;
+		}
+
+		/* Collect the run of groupable contexts */
+		dplane_ctx_enqueue_tail(&run_list, ctx);
+		while ((ctx = dplane_ctx_get_head(ctx_list)) != NULL &&
+		       nl_batch_ctx_groupable(ctx))
+			dplane_ctx_enqueue_tail(&run_list,
+						dplane_ctx_dequeue(ctx_list));
+
+		/* And emit it one namespace at a time */
+		while ((ctx = dplane_ctx_get_head(&run_list)) != NULL) {
+			ns_id = dplane_ctx_get_ns(ctx)->ns_id;
+
+			while ((ctx = dplane_ctx_dequeue(&run_list)) != NULL) {
+				if (dplane_ctx_get_ns(ctx)->ns_id == ns_id)
+					dplane_ctx_enqueue_tail(&out_list, ctx);
+				else
+					dplane_ctx_enqueue_tail(&rest_list,
+								ctx);
+			}
+
+			dplane_ctx_list_append(&run_list, &rest_list);
+		}
+	}
+
+	dplane_ctx_list_append(ctx_list, &out_list);
+}
+
 void kernel_update_multi(struct dplane_ctx_list_head *ctx_list)
 {
 	struct nl_batch batch;
@@ -1519,6 +1643,8 @@ void kernel_update_multi(struct dplane_ctx_list_head *ctx_list)
 	dplane_ctx_q_init(&handled_list);
 	nl_batch_init(&batch, &handled_list);
 
+	nl_batch_group_ns(ctx_list);
+
 	while (true) {
 		ctx = dplane_ctx_dequeue(ctx_list);
 		if (ctx == NULL)
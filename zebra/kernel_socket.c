@@ -1587,6 +1587,10 @@ int kernel_dplane_read(struct zebra_dplane_info *info)
 	return 0;
 }
 
+void kernel_update_multi_show(struct vty *vty)
+{
+}
+
 void kernel_update_multi(struct dplane_ctx_list_head *ctx_list)
 {
 	struct zebra_dplane_ctx *ctx;
@@ -33,6 +33,7 @@ DECLARE_MTYPE(RE);
 
 PREDECL_LIST(rnh_list);
 PREDECL_RBTREE_UNIQ(rnh_rbtree);
+PREDECL_DLIST(rnh_notify_list);
 
 /* Nexthop structure. */
 struct rnh {
@@ -41,6 +42,7 @@ struct rnh {
 #define ZEBRA_NHT_CONNECTED 0x1
 #define ZEBRA_NHT_DELETED 0x2
 #define ZEBRA_NHT_RESOLVE_VIA_DEFAULT 0x4
+#define ZEBRA_NHT_NOTIFY_PENDING 0x8
 
 	/* VRF identifier. */
 	vrf_id_t vrf_id;
@@ -69,6 +71,9 @@ struct rnh {
 	struct rnh_list_item rnh_list_item;
 
 	struct rnh_rbtree_item rnh_rbtree_item;
+
+	/* On the pending list while a client notification is delayed */
+	struct rnh_notify_list_item rnh_notify_item;
 };
 
 #define DISTANCE_INFINITY  255
@@ -112,6 +112,7 @@ extern int kernel_del_mac_nhg(uint32_t nhg_id);
  * Message batching interface.
  */
 extern void kernel_update_multi(struct dplane_ctx_list_head *ctx_list);
+extern void kernel_update_multi_show(struct vty *vty);
 
 /*
  * Called by the dplane pthread to read incoming OS messages and dispatch them.
@@ -2140,10 +2140,10 @@ static void zread_nhg_add(ZAPI_HANDLER_ARGS)
 		client->nhg_add_cnt++;
 }
 
-static void zread_route_add(ZAPI_HANDLER_ARGS)
+/* Add one decoded route, for ZEBRA_ROUTE_ADD and ZEBRA_ROUTE_ADD_BATCH */
+static void zapi_route_add(struct zserv *client, struct zebra_vrf *zvrf,
+			   struct zapi_route *api)
 {
-	struct stream *s;
-	struct zapi_route api;
 	afi_t afi;
 	struct prefix_ipv6 *src_p = NULL;
 	struct route_entry *re;
@@ -2153,33 +2153,25 @@ static void zread_route_add(ZAPI_HANDLER_ARGS)
 	vrf_id_t vrf_id;
 	struct nhg_hash_entry nhe = { 0 }, *n = NULL;
 
-	s = msg;
-	if (zapi_route_decode(s, &api) < 0) {
-		if (IS_ZEBRA_DEBUG_RECV)
-			zlog_debug("%s: Unable to decode zapi_route sent",
-				   __func__);
-		return;
-	}
-
 	vrf_id = zvrf_id(zvrf);
 
 	if (IS_ZEBRA_DEBUG_RECV)
 		zlog_debug("%s: p=(%s:%u)%pFX, msg flags=0x%x, flags=0x%x",
-			   __func__, zvrf_name(zvrf), api.tableid, &api.prefix,
-			   (int)api.message, api.flags);
+			   __func__, zvrf_name(zvrf), api->tableid, &api->prefix,
+			   (int)api->message, api->flags);
 
 	/* Allocate new route. */
 	re = zebra_rib_route_entry_new(
-		vrf_id, api.type, api.instance, api.flags, api.nhgid,
-		api.tableid ? api.tableid : zvrf->table_id, api.metric, api.mtu,
-		api.distance, api.tag);
+		vrf_id, api->type, api->instance, api->flags, api->nhgid,
+		api->tableid ? api->tableid : zvrf->table_id, api->metric, api->mtu,
+		api->distance, api->tag);
 
-	if (!CHECK_FLAG(api.message, ZAPI_MESSAGE_NHG)
-	    && (!CHECK_FLAG(api.message, ZAPI_MESSAGE_NEXTHOP)
-		|| api.nexthop_num == 0)) {
+	if (!CHECK_FLAG(api->message, ZAPI_MESSAGE_NHG)
+	    && (!CHECK_FLAG(api->message, ZAPI_MESSAGE_NEXTHOP)
+		|| api->nexthop_num == 0)) {
 		flog_warn(EC_ZEBRA_RX_ROUTE_NO_NEXTHOPS,
 			  "%s: received a route without nexthops for prefix (%s:%u)%pFX from client %s",
-			  __func__, zvrf_name(zvrf), api.tableid, &api.prefix,
+			  __func__, zvrf_name(zvrf), api->tableid, &api->prefix,
 			  zebra_route_string(client->proto));
 
 		zebra_rib_route_entry_free(re);
@@ -2187,22 +2179,22 @@ static void zread_route_add(ZAPI_HANDLER_ARGS)
 	}
 
 	/* Report misuse of the backup flag */
-	if (CHECK_FLAG(api.message, ZAPI_MESSAGE_BACKUP_NEXTHOPS)
-	    && api.backup_nexthop_num == 0) {
+	if (CHECK_FLAG(api->message, ZAPI_MESSAGE_BACKUP_NEXTHOPS)
+	    && api->backup_nexthop_num == 0) {
 		if (IS_ZEBRA_DEBUG_RECV || IS_ZEBRA_DEBUG_EVENT)
 			zlog_debug("%s: client %s: BACKUP flag set but no backup nexthops, prefix %pFX(%s:%u)",
-				   __func__, zebra_route_string(client->proto), &api.prefix,
-				   zvrf_name(zvrf), api.tableid);
+				   __func__, zebra_route_string(client->proto), &api->prefix,
+				   zvrf_name(zvrf), api->tableid);
 	}
 
 	if (!re->nhe_id
-	    && (!zapi_read_nexthops(client, &api.prefix, api.nexthops,
-				    api.flags, api.message, api.nexthop_num,
-				    api.backup_nexthop_num, &ng, NULL)
-		|| !zapi_read_nexthops(client, &api.prefix, api.backup_nexthops,
-				       api.flags, api.message,
-				       api.backup_nexthop_num,
-				       api.backup_nexthop_num, NULL, &bnhg))) {
+	    && (!zapi_read_nexthops(client, &api->prefix, api->nexthops,
+				    api->flags, api->message, api->nexthop_num,
+				    api->backup_nexthop_num, &ng, NULL)
+		|| !zapi_read_nexthops(client, &api->prefix, api->backup_nexthops,
+				       api->flags, api->message,
+				       api->backup_nexthop_num,
+				       api->backup_nexthop_num, NULL, &bnhg))) {
 
 		nexthop_group_delete(&ng);
 		zebra_nhg_backup_free(&bnhg);
@@ -2210,16 +2202,16 @@ static void zread_route_add(ZAPI_HANDLER_ARGS)
 		return;
 	}
 
-	if (CHECK_FLAG(api.message, ZAPI_MESSAGE_OPAQUE)) {
+	if (CHECK_FLAG(api->message, ZAPI_MESSAGE_OPAQUE)) {
 		re->opaque =
 			XMALLOC(MTYPE_RE_OPAQUE,
-				sizeof(struct re_opaque) + api.opaque.length);
-		re->opaque->length = api.opaque.length;
-		memcpy(re->opaque->data, api.opaque.data, re->opaque->length);
+				sizeof(struct re_opaque) + api->opaque.length);
+		re->opaque->length = api->opaque.length;
+		memcpy(re->opaque->data, api->opaque.data, re->opaque->length);
 	}
 
-	afi = family2afi(api.prefix.family);
-	if (afi != AFI_IP6 && CHECK_FLAG(api.message, ZAPI_MESSAGE_SRCPFX)) {
+	afi = family2afi(api->prefix.family);
+	if (afi != AFI_IP6 && CHECK_FLAG(api->message, ZAPI_MESSAGE_SRCPFX)) {
 		flog_warn(EC_ZEBRA_RX_SRCDEST_WRONG_AFI,
 			  "%s: Received SRC Prefix but afi is not v6",
 			  __func__);
@@ -2228,13 +2220,13 @@ static void zread_route_add(ZAPI_HANDLER_ARGS)
 		zebra_rib_route_entry_free(re);
 		return;
 	}
-	if (CHECK_FLAG(api.message, ZAPI_MESSAGE_SRCPFX))
-		src_p = &api.src_prefix;
+	if (CHECK_FLAG(api->message, ZAPI_MESSAGE_SRCPFX))
+		src_p = &api->src_prefix;
 
-	if (api.safi != SAFI_UNICAST && api.safi != SAFI_MULTICAST) {
+	if (api->safi != SAFI_UNICAST && api->safi != SAFI_MULTICAST) {
 		flog_warn(EC_LIB_ZAPI_MISSMATCH,
 			  "%s: Received safi: %d but we can only accept UNICAST or MULTICAST",
-			  __func__, api.safi);
+			  __func__, api->safi);
 		nexthop_group_delete(&ng);
 		zebra_nhg_backup_free(&bnhg);
 		zebra_rib_route_entry_free(re);
@@ -2250,14 +2242,20 @@ static void zread_route_add(ZAPI_HANDLER_ARGS)
 	 * Include backup info with the route. We use a temporary nhe here;
 	 * if this is a new/unknown nhe, a new copy will be allocated
 	 * and stored.
+	 *
+	 * The nexthops and backup info we just decoded aren't used for
+	 * anything else, so hand them over to the temporary nhe rather
+	 * than having zebra_nhe_copy() duplicate them.
 	 */
 	if (!re->nhe_id) {
 		zebra_nhe_init(&nhe, afi, ng->nexthop);
-		nhe.nhg.nexthop = ng->nexthop;
-		nhe.backup_info = bnhg;
 		n = zebra_nhe_copy(&nhe, 0);
+		n->nhg.nexthop = ng->nexthop;
+		ng->nexthop = NULL;
+		n->backup_info = bnhg;
+		bnhg = NULL;
 	}
-	ret = rib_add_multipath_nhe(afi, api.safi, &api.prefix, src_p, re, n, false, true);
+	ret = rib_add_multipath_nhe(afi, api->safi, &api->prefix, src_p, re, n, false, true);
 
 	/*
 	 * rib_add_multipath_nhe only fails in a couple spots
@@ -2277,7 +2275,7 @@ static void zread_route_add(ZAPI_HANDLER_ARGS)
 		zebra_nhg_backup_free(&bnhg);
 
 	/* Stats */
-	switch (api.prefix.family) {
+	switch (api->prefix.family) {
 	case AF_INET:
 		if (ret == 0)
 			client->v4_route_add_cnt++;
@@ -2293,6 +2291,48 @@ static void zread_route_add(ZAPI_HANDLER_ARGS)
 	}
 }
 
+static void zread_route_add(ZAPI_HANDLER_ARGS)
+{
+	struct stream *s;
+	struct zapi_route api;
+
+	s = msg;
+	if (zapi_route_decode(s, &api) < 0) {
+		if (IS_ZEBRA_DEBUG_RECV)
+			zlog_debug("%s: Unable to decode zapi_route sent",
+				   __func__);
+		return;
+	}
+
+	zapi_route_add(client, zvrf, &api);
+}
+
+/*
+ * A batch is one route add followed by more prefixes sharing its
+ * nexthops and attributes; see zapi_route_batch_add().
+ */
+static void zread_route_add_batch(ZAPI_HANDLER_ARGS)
+{
+	struct stream *s;
+	struct zapi_route api;
+	int ret;
+
+	s = msg;
+	if (zapi_route_decode(s, &api) < 0) {
+		if (IS_ZEBRA_DEBUG_RECV)
+			zlog_debug("%s: Unable to decode zapi_route sent",
+				   __func__);
+		return;
+	}
+
+	do {
+		zapi_route_add(client, zvrf, &api);
+	} while ((ret = zapi_route_batch_decode_prefix(s, &api)) > 0);
+
+	if (ret < 0 && IS_ZEBRA_DEBUG_RECV)
+		zlog_debug("%s: Unable to decode batched prefix", __func__);
+}
+
 void zapi_re_opaque_free(struct route_entry *re)
 {
 	XFREE(MTYPE_RE_OPAQUE, re->opaque);
@@ -4162,6 +4202,7 @@ void (*const zserv_handlers[])(ZAPI_HANDLER_ARGS) = {
 	[ZEBRA_INTERFACE_SET_PROTODOWN] = zread_interface_set_protodown,
 	[ZEBRA_ROUTE_ADD] = zread_route_add,
 	[ZEBRA_ROUTE_DELETE] = zread_route_del,
+	[ZEBRA_ROUTE_ADD_BATCH] = zread_route_add_batch,
 	[ZEBRA_REDISTRIBUTE_ADD] = zebra_redistribute_add,
 	[ZEBRA_REDISTRIBUTE_DELETE] = zebra_redistribute_delete,
 	[ZEBRA_REDISTRIBUTE_DEFAULT_ADD] = zebra_redistribute_default_add,
@@ -6481,6 +6481,10 @@ int dplane_show_helper(struct vty *vty, bool detailed)
 				    memory_order_relaxed);
 	vty_out(vty, "GRE set updates:       %"PRIu64"\n", incoming);
 	vty_out(vty, "GRE set errors:        %"PRIu64"\n", errs);
+
+	if (detailed)
+		kernel_update_multi_show(vty);
+
 	return CMD_SUCCESS;
 }
 
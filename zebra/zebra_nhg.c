@@ -479,6 +479,20 @@ static void *zebra_nhg_hash_alloc(void *arg)
 	return nhe;
 }
 
+/*
+ * Allocation via hash handler for a new zebra hashed/owned NHG: assigns
+ * the next global id to the lookup nhe, so that the caller can tell that
+ * hash_get() created the entry.
+ */
+static void *zebra_nhg_hash_alloc_new(void *arg)
+{
+	struct nhg_hash_entry *lookup = arg;
+
+	lookup->id = nhg_get_next_id();
+
+	return zebra_nhg_hash_alloc(lookup);
+}
+
 uint32_t zebra_nhg_hash_key(const void *arg)
 {
 	const struct nhg_hash_entry *nhe = arg;
@@ -707,6 +721,7 @@ static bool zebra_nhe_find(struct nhg_hash_entry **nhe, /* return value */
 			   afi_t afi, bool from_dplane)
 {
 	bool created = false;
+	bool hashed_new = false;
 	bool recursive = false;
 	struct nhg_hash_entry *newnhe, *backup_nhe;
 	struct nexthop *nh = NULL;
@@ -714,7 +729,15 @@ static bool zebra_nhe_find(struct nhg_hash_entry **nhe, /* return value */
 
 	if (lookup->id)
 		(*nhe) = zebra_nhg_lookup_id(lookup->id);
-	else
+	else if (!from_dplane) {
+		/*
+		 * Find or create the zebra hashed/owned NHG in a single hash
+		 * operation, so the nexthops only get hashed once either way.
+		 */
+		(*nhe) = hash_get(zrouter.nhgs, lookup,
+				  zebra_nhg_hash_alloc_new);
+		hashed_new = (lookup->id != 0);
+	} else
 		(*nhe) = hash_lookup(zrouter.nhgs, lookup);
 
 	if (IS_ZEBRA_DEBUG_NHG_DETAIL)
@@ -724,7 +747,7 @@ static bool zebra_nhe_find(struct nhg_hash_entry **nhe, /* return value */
 			   (from_dplane ? " (from dplane)" : ""), *nhe, *nhe);
 
 	/* If we found an existing object, we're done */
-	if (*nhe)
+	if (*nhe && !hashed_new)
 		goto done;
 
 	/* We're going to create/insert a new nhe:
@@ -733,7 +756,11 @@ static bool zebra_nhe_find(struct nhg_hash_entry **nhe, /* return value */
 	if (lookup->id == 0)
 		lookup->id = nhg_get_next_id();
 
-	if (!from_dplane && lookup->id < ZEBRA_NHG_PROTO_LOWER) {
+	if (hashed_new) {
+		/* Already in the HASH table, just needs the ID table */
+		newnhe = *nhe;
+		zebra_nhg_insert_id(newnhe);
+	} else if (!from_dplane && lookup->id < ZEBRA_NHG_PROTO_LOWER) {
 		/*
 		 * This is a zebra hashed/owned NHG.
 		 *
@@ -918,7 +918,7 @@ void zebra_rib_evaluate_rn_nexthops(struct route_node *rn, uint32_t seq,
 		frr_each_safe(rnh_list, &dest->nht, rnh) {
 			struct zebra_vrf *zvrf =
 				zebra_vrf_lookup_by_id(rnh->vrf_id);
-			struct prefix *p = &rnh->node->p;
+			const struct prefix *p = &rnh->node->p;
 
 			if (IS_ZEBRA_DEBUG_NHT_DETAILED)
 				zlog_debug(
@@ -945,9 +945,14 @@ void zebra_rib_evaluate_rn_nexthops(struct route_node *rn, uint32_t seq,
 				continue;
 			}
 
-			rnh->seqno = seq;
-			zebra_evaluate_rnh(zvrf, family2afi(p->family), 0, p,
-					   rnh->safi);
+			/*
+			 * One evaluation re-resolves every client's rnh for
+			 * this tracked prefix, and marks them all with seq.
+			 * Siblings later on this list (or re-added to its
+			 * tail by the evaluation) are skipped above.
+			 */
+			zebra_evaluate_rnh_seq(zvrf, family2afi(p->family), rnh,
+					       seq);
 		}
 
 		rn = rn->parent;
@@ -86,8 +86,18 @@ static int rnh_rbtree_cmp(const struct rnh *rnh1, const struct rnh *rnh2)
 /* Declare the hash implementation - this stays private to zebra_rnh.c */
 DECLARE_RBTREE_UNIQ(rnh_rbtree, struct rnh, rnh_rbtree_item, rnh_rbtree_cmp);
 
+/*
+ * rnhs whose client notification is being held back by
+ * 'zebra nexthop-tracking notify-delay', and the timer that sends them.
+ */
+DECLARE_DLIST(rnh_notify_list, struct rnh, rnh_notify_item);
+
+static struct rnh_notify_list_head rnh_notify_pending;
+static struct event *t_rnh_notify;
+
 void zebra_rnh_init(void)
 {
+	rnh_notify_list_init(&rnh_notify_pending);
 	hook_register(zserv_client_close, zebra_client_cleanup_rnh);
 }
 
@@ -290,6 +300,9 @@ void zebra_free_rnh(struct rnh *rnh)
 	rnh->flags |= ZEBRA_NHT_DELETED;
 	list_delete(&rnh->zebra_pseudowire_list);
 
+	if (CHECK_FLAG(rnh->flags, ZEBRA_NHT_NOTIFY_PENDING))
+		rnh_notify_list_del(&rnh_notify_pending, rnh);
+
 	zvrf = zebra_vrf_lookup_by_id(rnh->vrf_id);
 	if (zvrf) {
 		table = zvrf->table[family2afi(rnh->resolved_route.family)][rnh->safi];
@@ -593,6 +606,78 @@ static void zebra_rnh_notify_protocol_clients(struct zebra_vrf *zvrf, afi_t afi,
 		zebra_rnh_clear_nexthop_rnh_filters(re);
 }
 
+/*
+ * Send the notifications held back by the notify-delay.  Each rnh is sent
+ * once with whatever state it has now, however many times it changed
+ * while it was waiting.
+ */
+static void zebra_rnh_notify_pending(struct event *event)
+{
+	struct zebra_vrf *zvrf;
+	struct route_table *table;
+	struct route_node *prn;
+	struct rnh *rnh;
+
+	while ((rnh = rnh_notify_list_pop(&rnh_notify_pending))) {
+		UNSET_FLAG(rnh->flags, ZEBRA_NHT_NOTIFY_PENDING);
+
+		zvrf = zebra_vrf_lookup_by_id(rnh->vrf_id);
+		if (!zvrf)
+			continue;
+
+		/* Find the node we resolved over again, if we still do */
+		prn = NULL;
+		table = zvrf->table[rnh->afi][rnh->safi];
+		if (rnh->state && table)
+			prn = route_node_match(table, &rnh->resolved_route);
+
+		zebra_rnh_notify_protocol_clients(zvrf, rnh->afi, rnh->node, rnh,
+						  prn, rnh->state);
+
+		if (prn)
+			route_unlock_node(prn);
+	}
+}
+
+/*
+ * Notify the client for this RNH now, or hold the notification back
+ * for the configured notify-delay so that a burst of changes (e.g. an
+ * IGP flap) turns into one update per tracked nexthop.
+ */
+static void zebra_rnh_notify_or_delay(struct zebra_vrf *zvrf, afi_t afi,
+				      int force, struct route_node *nrn,
+				      struct rnh *rnh, struct route_node *prn,
+				      struct route_entry *re)
+{
+	if (force || !zrouter.nht_notify_delay || !rnh->client ||
+	    rnh->client == PSEUDOWIRE_CLIENT) {
+		if (CHECK_FLAG(rnh->flags, ZEBRA_NHT_NOTIFY_PENDING)) {
+			rnh_notify_list_del(&rnh_notify_pending, rnh);
+			UNSET_FLAG(rnh->flags, ZEBRA_NHT_NOTIFY_PENDING);
+		}
+
+		zebra_rnh_notify_protocol_clients(zvrf, afi, nrn, rnh, prn, re);
+		return;
+	}
+
+	if (CHECK_FLAG(rnh->flags, ZEBRA_NHT_NOTIFY_PENDING))
+		return;
+
+	SET_FLAG(rnh->flags, ZEBRA_NHT_NOTIFY_PENDING);
+	rnh_notify_list_add_tail(&rnh_notify_pending, rnh);
+
+	if (IS_ZEBRA_DEBUG_NHT)
+		zlog_debug("%s(%u):%pRN: Delaying notification to client %s by %ums",
+			   VRF_LOGNAME(zvrf->vrf), zvrf->vrf->vrf_id, nrn,
+			   zebra_route_string(rnh->client->proto),
+			   zrouter.nht_notify_delay);
+
+	if (!event_is_scheduled(t_rnh_notify))
+		event_add_timer_msec(zrouter.master, zebra_rnh_notify_pending,
+				     NULL, zrouter.nht_notify_delay,
+				     &t_rnh_notify);
+}
+
 /*
  * Utility to determine whether a candidate nexthop is useable. We make this
  * check in a couple of places, so this is a single home for the logic we
@@ -822,8 +907,8 @@ static void zebra_rnh_eval_nexthop_entry(struct zebra_vrf *zvrf, afi_t afi,
 		 * rnh->state.
 		 */
 		/* Notify registered protocol clients. */
-		zebra_rnh_notify_protocol_clients(zvrf, afi, nrn, rnh, prn,
-						  rnh->state);
+		zebra_rnh_notify_or_delay(zvrf, afi, force, nrn, rnh, prn,
+					  rnh->state);
 
 		/* Process pseudowires attached to this nexthop */
 		zebra_rnh_process_pseudowires(zvrf->vrf->vrf_id, rnh);
@@ -935,6 +1020,30 @@ void zebra_evaluate_rnh(struct zebra_vrf *zvrf, afi_t afi, int force,
 	}
 }
 
+/*
+ * Evaluate the tracked prefix that 'rnh' belongs to on behalf of a change
+ * to a route node it resolves over.  All the rnhs sharing that prefix (one
+ * per client) are re-resolved by the single evaluation, so stamp them all
+ * with 'seq' to keep the caller's walk from evaluating the prefix again
+ * for each sibling it finds on the resolving node.
+ */
+void zebra_evaluate_rnh_seq(struct zebra_vrf *zvrf, afi_t afi, struct rnh *rnh,
+			    uint32_t seq)
+{
+	struct route_node *nrn = rnh->node;
+	struct rnh_container *rnhc;
+	struct rnh *sib;
+
+	rnhc = nrn->info;
+	if (!rnhc)
+		return;
+
+	frr_each (rnh_rbtree, &rnhc->rnh_rbtree, sib)
+		sib->seqno = seq;
+
+	zebra_rnh_evaluate_entry(zvrf, afi, 0, nrn);
+}
+
 void zebra_print_rnh_table(vrf_id_t vrfid, afi_t afi, safi_t safi,
 			   struct vty *vty, const struct prefix *p,
 			   json_object *json)
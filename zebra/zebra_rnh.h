@@ -42,6 +42,8 @@ extern void zebra_deregister_rnh_pseudowire(vrf_id_t vrf_id, struct zebra_pw *pw
 extern void zebra_remove_rnh_client(struct rnh *rnh, struct zserv *client);
 extern void zebra_evaluate_rnh(struct zebra_vrf *zvrf, afi_t afi, int force,
 			       const struct prefix *p, safi_t safi);
+extern void zebra_evaluate_rnh_seq(struct zebra_vrf *zvrf, afi_t afi,
+				   struct rnh *rnh, uint32_t seq);
 extern void zebra_print_rnh_table(vrf_id_t vrfid, afi_t afi, safi_t safi,
 				  struct vty *vty, const struct prefix *p,
 				  struct json_object *json);
@@ -297,6 +297,8 @@ void zebra_router_init(bool asic_offload, bool notify_on_ack, bool v6_with_v4_ne
 
 	zrouter.nhg_keep = ZEBRA_DEFAULT_NHG_KEEP_TIMER;
 
+	zrouter.nht_notify_delay = 0;
+
 	zrouter.gr_stale_cleanup_time_recorded = false;
 	zrouter.gr_update_pending_time_recorded = false;
 
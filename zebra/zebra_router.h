@@ -232,6 +232,9 @@ struct zebra_router {
 #define ZEBRA_DEFAULT_NHG_KEEP_TIMER 180
 	uint32_t nhg_keep;
 
+	/* Milliseconds to coalesce nexthop tracking notifications, 0 = off */
+	uint32_t nht_notify_delay;
+
 	/* Should we allow non FRR processes to delete our routes */
 	bool allow_delete;
 
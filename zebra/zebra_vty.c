@@ -3793,6 +3793,23 @@ DEFPY (zebra_nexthop_group_keep,
 	return CMD_SUCCESS;
 }
 
+DEFPY (zebra_nexthop_tracking_notify_delay,
+       zebra_nexthop_tracking_notify_delay_cmd,
+       "[no] zebra nexthop-tracking notify-delay ![(1-10000)$delay]",
+       NO_STR
+       ZEBRA_STR
+       "Nexthop tracking\n"
+       "Coalesce client notifications\n"
+       "Time in milliseconds from 1-10000\n")
+{
+	if (no)
+		zrouter.nht_notify_delay = 0;
+	else
+		zrouter.nht_notify_delay = delay;
+
+	return CMD_SUCCESS;
+}
+
 static int config_write_protocol(struct vty *vty)
 {
 	if (zrouter.allow_delete)
@@ -3801,6 +3818,10 @@ static int config_write_protocol(struct vty *vty)
 	if (zrouter.nhg_keep != ZEBRA_DEFAULT_NHG_KEEP_TIMER)
 		vty_out(vty, "zebra nexthop-group keep %u\n", zrouter.nhg_keep);
 
+	if (zrouter.nht_notify_delay)
+		vty_out(vty, "zebra nexthop-tracking notify-delay %u\n",
+			zrouter.nht_notify_delay);
+
 	if (zrouter.ribq->spec.hold != ZEBRA_RIB_PROCESS_HOLD_TIME)
 		vty_out(vty, "zebra work-queue %u\n", zrouter.ribq->spec.hold);
 
@@ -4277,6 +4298,7 @@ void zebra_vty_init(void)
 	install_node(&protocol_node);
 
 	install_element(CONFIG_NODE, &zebra_nexthop_group_keep_cmd);
+	install_element(CONFIG_NODE, &zebra_nexthop_tracking_notify_delay_cmd);
 	install_element(CONFIG_NODE, &nexthop_group_use_enable_cmd);
 	install_element(CONFIG_NODE, &proto_nexthop_group_only_cmd);
 	install_element(CONFIG_NODE, &backup_nexthop_recursive_use_enable_cmd);